@@ -0,0 +1,133 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "OpenGLUtil.h"
+#include "Benchmark.h"
+#include "Framebuffer.h"
+#include "HeadlessContext.h"
+#include "TraceReplayer.h"
+
+using std::cout;
+using std::endl;
+using std::string;
+
+struct ReplayOptions {
+    string tracePath;
+    unsigned int frameCount;    //How many frames to measure. We loop over the trace's frames as many times as it takes.
+    unsigned int warmupFrames;
+    int width;                  //Of the framebuffer we draw into wherever the trace drew to its window
+    int height;
+    string csvPath;
+    string jsonPath;
+};
+
+ReplayOptions parseOptions(int argc, char** argv);
+bool initGlew();
+
+/// <summary>
+/// Replays a GL trace captured with OpenGLBasics --capture, timing each frame, so we can measure the driver's cost on its own
+/// (and compare drivers, e.g. llvmpipe versions, on exactly the same calls).
+/// </summary>
+int main(int argc, char** argv) {
+    ReplayOptions options = parseOptions(argc, argv);
+    if (options.tracePath.empty()) {
+        cout << "Usage: GLReplay <trace> [--frames N] [--warmup N] [--width W] [--height H] [--csv path] [--json path]" << endl;
+        return -1;
+    }
+
+    TraceReplayer replayer;
+    if (!replayer.load(options.tracePath))
+        return -1;
+    if (replayer.getFrameCount() == 0) {
+        cout << "The trace only has its setup frame, so there's nothing to loop over!" << endl;
+        return -1;
+    }
+
+    HeadlessContext context;
+    if (!context.isValid()) {
+        cout << "Failed to create a headless OpenGL context!" << endl;
+        return -1;
+    }
+    if (!initGlew())
+        return -1;
+    if (GL_CHECK_LEVEL == GL_CHECK_CALLBACK)
+        glInstallDebugCallback();
+
+    cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
+    cout << "OpenGL Renderer: " << glGetString(GL_RENDERER) << endl;
+    cout << "Trace: " << options.tracePath << " (" << replayer.getSize() / (1024.0 * 1024.0) << " MB, "
+        << replayer.getFrameCount() << " frames after setup)" << endl;
+
+    {
+        Framebuffer framebuffer = Framebuffer(options.width, options.height);
+        framebuffer.bind();
+        replayer.setDefaultFramebuffer(framebuffer.getRendererId());
+
+        replayer.replaySetup();
+
+        Benchmark benchmark(options.warmupFrames, options.frameCount);
+        for (unsigned int frame = 0; !benchmark.isDone(); frame++) {
+            benchmark.beginFrame();
+            replayer.replayFrame(frame % replayer.getFrameCount());
+            benchmark.endSubmit();
+            glFlush();
+            benchmark.endFrame();
+        }
+        glFinish();
+
+        benchmark.finish();
+        benchmark.printReport();
+        if (!options.csvPath.empty() && benchmark.writeCsv(options.csvPath))
+            cout << "Wrote per-frame timings to " << options.csvPath << endl;
+        if (!options.jsonPath.empty() && benchmark.writeJson(options.jsonPath))
+            cout << "Wrote the benchmark summary to " << options.jsonPath << endl;
+    } //Clean up before the context goes away.
+
+    return 0;
+}
+
+ReplayOptions parseOptions(int argc, char** argv) {
+    ReplayOptions options = {
+        "",
+        300,
+        30,
+        640,
+        480,
+        "",
+        ""
+    };
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue)
+            options.frameCount = (unsigned int) atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && hasValue)
+            options.warmupFrames = (unsigned int) atoi(argv[++i]);
+        else if (strcmp(argv[i], "--width") == 0 && hasValue)
+            options.width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--height") == 0 && hasValue)
+            options.height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && hasValue)
+            options.csvPath = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && hasValue)
+            options.jsonPath = argv[++i];
+        else if (argv[i][0] != '-' && options.tracePath.empty())
+            options.tracePath = argv[i];
+        else
+            cout << "Ignoring unknown option: " << argv[i] << endl;
+    }
+    return options;
+}
+
+bool initGlew() {
+    //NOTE: Same as OpenGLBasics: core profile entry points need glewExperimental, and there's no GLX display when we're on EGL.
+    glewExperimental = GL_TRUE;
+    GLenum result = glewInit();
+    if (result != GLEW_OK && result != GLEW_ERROR_NO_GLX_DISPLAY) {
+        cout << "Failed to initialize GLEW: " << glewGetErrorString(result) << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,823 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "OpenGLUtil.h"
+#include "GLTraceFormat.h"
+#include "TraceReplayer.h"
+
+using std::cout;
+using std::endl;
+
+TraceReplayer::Reader::Reader(const char* data, const char* end)
+    : data(data),
+    end(end),
+    failed(false) { }
+
+bool TraceReplayer::Reader::canRead(size_t size) {
+    if ((size_t) (end - data) < size) {
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+uint32_t TraceReplayer::Reader::read32() {
+    if (!canRead(4))
+        return 0;
+    uint32_t value;
+    memcpy(&value, data, 4);
+    data += 4;
+    return value;
+}
+
+int32_t TraceReplayer::Reader::readInt() {
+    return (int32_t) read32();
+}
+
+uint64_t TraceReplayer::Reader::read64() {
+    if (!canRead(8))
+        return 0;
+    uint64_t value;
+    memcpy(&value, data, 8);
+    data += 8;
+    return value;
+}
+
+float TraceReplayer::Reader::readFloat() {
+    if (!canRead(4))
+        return 0;
+    float value;
+    memcpy(&value, data, 4);
+    data += 4;
+    return value;
+}
+
+const void* TraceReplayer::Reader::readPayload(uint32_t& size) {
+    size = read32();
+    if (size == GL_TRACE_NULL_PAYLOAD || !canRead(size)) {
+        size = 0;
+        return nullptr;
+    }
+    const void* payload = data;
+    data += size;
+    return payload;
+}
+
+TraceReplayer::TraceReplayer()
+    : setupEnd(0),
+    defaultFramebuffer(0),
+    currentProgram(0) { }
+
+bool TraceReplayer::load(const string& filePath) {
+    std::ifstream stream = std::ifstream(filePath, std::ios::binary | std::ios::ate);
+    if (!stream) {
+        cout << "Failed to open " << filePath << "!" << endl;
+        return false;
+    }
+    trace.resize((size_t) stream.tellg());
+    stream.seekg(0);
+    stream.read(trace.data(), trace.size());
+
+    Reader header = Reader(trace.data(), trace.data() + trace.size());
+    if (trace.size() < 8 || header.read32() != GL_TRACE_MAGIC) {
+        cout << filePath << " isn't a GL trace!" << endl;
+        return false;
+    }
+    uint32_t version = header.read32();
+    if (version != GL_TRACE_VERSION) {
+        cout << filePath << " is a version " << version << " trace, but we only know version " << GL_TRACE_VERSION << "." << endl;
+        return false;
+    }
+
+    //Find the frames, using each record's size to skip over it.
+    setupEnd = 0;
+    frames.clear();
+    size_t frameStart = 8;
+    size_t position = 8;
+    while (position + 5 <= trace.size()) {
+        uint8_t op = (uint8_t) trace[position];
+        uint32_t size;
+        memcpy(&size, &trace[position + 1], 4);
+
+        //NOTE: Like when the app was killed in the middle of capturing. The frames before it are still fine.
+        if (size > trace.size() - position - 5) {
+            cout << filePath << " is cut off (or corrupt) at byte " << position << ", so we'll ignore everything from there on." << endl;
+            break;
+        }
+        position += 5 + size;
+
+        if (op == GL_TRACE_FRAME) {
+            if (setupEnd == 0)
+                setupEnd = position;
+            else
+                frames.push_back(std::pair<size_t, size_t>(frameStart, position));
+            frameStart = position;
+        }
+    }
+    //NOTE: Anything after the last frame (cleanup, usually) is never replayed.
+
+    if (setupEnd == 0) {
+        cout << filePath << " doesn't have any frames!" << endl;
+        return false;
+    }
+    return true;
+}
+
+void TraceReplayer::setDefaultFramebuffer(unsigned int framebuffer) {
+    defaultFramebuffer = framebuffer;
+}
+
+void TraceReplayer::replaySetup() {
+    replay(8, setupEnd);
+}
+
+void TraceReplayer::replayFrame(unsigned int index) {
+    replay(frames[index].first, frames[index].second);
+}
+
+void TraceReplayer::replay(size_t start, size_t end) {
+    size_t position = start;
+    while (position < end) {
+        uint8_t op = (uint8_t) trace[position];
+        uint32_t size;
+        memcpy(&size, &trace[position + 1], 4);
+
+        Reader reader = Reader(&trace[position + 5], &trace[position + 5] + size);
+        replayRecord(op, reader, position);
+        if (reader.hasFailed())
+            cout << "Record " << (unsigned int) op << " at byte " << position << " is shorter than its arguments! They were read as 0." << endl;
+        position += 5 + size;
+    }
+}
+
+int TraceReplayer::getUniformLocation(int captured) const {
+    if (captured == -1)
+        return -1;
+    unordered_map<uint64_t, int>::const_iterator it = uniformLocations.find(((uint64_t) currentProgram << 32) | (uint32_t) captured);
+    return it != uniformLocations.end() ? it->second : captured;
+}
+
+unsigned int TraceReplayer::mapName(const unordered_map<unsigned int, unsigned int>& names, unsigned int captured) {
+    //NOTE: 0 is never a generated name (it's the default object, or none), and names we never saw created (e.g. from a partial trace) are used as-is.
+    if (captured == 0)
+        return 0;
+    unordered_map<unsigned int, unsigned int>::const_iterator it = names.find(captured);
+    return it != names.end() ? it->second : captured;
+}
+
+void TraceReplayer::genNames(unordered_map<unsigned int, unsigned int>& names, Reader& reader, void (GLAPIENTRY *gen)(GLsizei, GLuint*)) {
+    GLsizei n = reader.readInt();
+    if (n < 0 || !reader.canRead(n * sizeof(GLuint)))
+        return;
+    vector<GLuint> generated = vector<GLuint>(n);
+    gen(n, generated.data());
+    for (GLsizei i = 0; i < n; i++)
+        names[reader.read32()] = generated[i];
+}
+
+void TraceReplayer::deleteNames(unordered_map<unsigned int, unsigned int>& names, Reader& reader, void (GLAPIENTRY *del)(GLsizei, const GLuint*)) {
+    GLsizei n = reader.readInt();
+    if (n < 0 || !reader.canRead(n * sizeof(GLuint)))
+        return;
+    vector<GLuint> deleted = vector<GLuint>(n);
+    for (GLsizei i = 0; i < n; i++) {
+        unsigned int captured = reader.read32();
+        deleted[i] = mapName(names, captured);
+        names.erase(captured);
+    }
+    del(n, deleted.data());
+}
+
+//NOTE: No GLCALL in here, since this is the loop we're timing. Errors still reach the debug callback (see glInstallDebugCallback).
+void TraceReplayer::replayRecord(uint8_t op, Reader& reader, size_t position) {
+    uint32_t size;
+    switch (op) {
+        case GL_TRACE_FRAME:
+            break;
+
+        case GL_TRACE_GEN_BUFFERS:
+            genNames(buffers, reader, glGenBuffers);
+            break;
+        case GL_TRACE_DELETE_BUFFERS: {
+            //NOTE: Deleting a buffer unmaps it.
+            Reader names = reader;
+            GLsizei n = names.readInt();
+            if (n < 0 || !names.canRead(n * sizeof(GLuint)))
+                n = 0;
+            for (GLsizei i = 0; i < n; i++)
+                mappings.erase(names.read32());
+            deleteNames(buffers, reader, glDeleteBuffers);
+            break;
+        }
+        case GL_TRACE_BIND_BUFFER: {
+            GLenum target = reader.read32();
+            unsigned int buffer = reader.read32();
+            boundBuffers[target] = buffer;
+            glBindBuffer(target, mapName(buffers, buffer));
+            break;
+        }
+        case GL_TRACE_BIND_BUFFER_BASE: {
+            GLenum target = reader.read32();
+            GLuint index = reader.read32();
+            unsigned int buffer = reader.read32();
+            boundBuffers[target] = buffer;
+            glBindBufferBase(target, index, mapName(buffers, buffer));
+            break;
+        }
+        case GL_TRACE_BUFFER_DATA: {
+            GLenum target = reader.read32();
+            GLsizeiptr bufferSize = (GLsizeiptr) reader.read64();
+            const void* data = reader.readPayload(size);
+            glBufferData(target, bufferSize, data, reader.read32());
+            break;
+        }
+        case GL_TRACE_BUFFER_SUB_DATA: {
+            GLenum target = reader.read32();
+            GLintptr offset = (GLintptr) reader.read64();
+            const void* data = reader.readPayload(size);
+            glBufferSubData(target, offset, size, data);
+            break;
+        }
+        case GL_TRACE_BUFFER_STORAGE: {
+            GLenum target = reader.read32();
+            GLsizeiptr bufferSize = (GLsizeiptr) reader.read64();
+            const void* data = reader.readPayload(size);
+            glBufferStorage(target, bufferSize, data, reader.read32());
+            break;
+        }
+        case GL_TRACE_MAP_BUFFER_RANGE: {
+            GLenum target = reader.read32();
+            uint64_t offset = reader.read64();
+            GLsizeiptr length = (GLsizeiptr) reader.read64();
+            GLbitfield access = reader.read32();
+            char* pointer = (char*) glMapBufferRange(target, (GLintptr) offset, length, access);
+            Mapping mapping = { pointer, offset, (uint64_t) length };
+            mappings[boundBuffers[target]] = mapping;
+            break;
+        }
+        case GL_TRACE_UNMAP_BUFFER: {
+            GLenum target = reader.read32();
+            mappings.erase(boundBuffers[target]);
+            glUnmapBuffer(target);
+            break;
+        }
+        case GL_TRACE_MAPPED_WRITE: {
+            unsigned int buffer = reader.read32();
+            uint64_t offset = reader.read64();
+            const void* data = reader.readPayload(size);
+            unordered_map<unsigned int, Mapping>::iterator it = mappings.find(buffer);
+            if (it == mappings.end() || it->second.pointer == nullptr || data == nullptr)
+                break;
+
+            //NOTE: Written this way round so a huge offset can't wrap around and pass.
+            const Mapping& mapping = it->second;
+            if (offset < mapping.offset || offset - mapping.offset > mapping.length || size > mapping.length - (offset - mapping.offset)) {
+                cout << "Mapped write at byte " << position << " falls outside the range its buffer has mapped! Skipping it." << endl;
+                break;
+            }
+            memcpy(mapping.pointer + (offset - mapping.offset), data, size);
+            break;
+        }
+
+        case GL_TRACE_GEN_VERTEX_ARRAYS:
+            genNames(vertexArrays, reader, glGenVertexArrays);
+            break;
+        case GL_TRACE_DELETE_VERTEX_ARRAYS:
+            deleteNames(vertexArrays, reader, glDeleteVertexArrays);
+            break;
+        case GL_TRACE_BIND_VERTEX_ARRAY:
+            glBindVertexArray(mapName(vertexArrays, reader.read32()));
+            break;
+        case GL_TRACE_ENABLE_VERTEX_ATTRIB_ARRAY:
+            glEnableVertexAttribArray(reader.read32());
+            break;
+        case GL_TRACE_VERTEX_ATTRIB_POINTER: {
+            GLuint index = reader.read32();
+            GLint components = reader.readInt();
+            GLenum type = reader.read32();
+            GLboolean normalized = (GLboolean) reader.read32();
+            GLsizei stride = reader.readInt();
+            glVertexAttribPointer(index, components, type, normalized, stride, (const void*) (uintptr_t) reader.read64());
+            break;
+        }
+        case GL_TRACE_VERTEX_ATTRIB_DIVISOR: {
+            GLuint index = reader.read32();
+            glVertexAttribDivisor(index, reader.read32());
+            break;
+        }
+
+        case GL_TRACE_CREATE_SHADER: {
+            GLenum type = reader.read32();
+            shaders[reader.read32()] = glCreateShader(type);
+            break;
+        }
+        case GL_TRACE_SHADER_SOURCE: {
+            unsigned int shader = reader.read32();
+            GLsizei count = reader.readInt();
+            if (count < 0 || !reader.canRead(count * sizeof(uint32_t)))
+                break;
+            vector<const GLchar*> strings = vector<const GLchar*>(count);
+            vector<GLint> lengths = vector<GLint>(count);
+            for (GLsizei i = 0; i < count; i++) {
+                strings[i] = (const GLchar*) reader.readPayload(size);
+                lengths[i] = (GLint) size;
+            }
+            glShaderSource(mapName(shaders, shader), count, strings.data(), lengths.data());
+            break;
+        }
+        case GL_TRACE_COMPILE_SHADER:
+            glCompileShader(mapName(shaders, reader.read32()));
+            break;
+        case GL_TRACE_DELETE_SHADER: {
+            unsigned int shader = reader.read32();
+            glDeleteShader(mapName(shaders, shader));
+            shaders.erase(shader);
+            break;
+        }
+        case GL_TRACE_CREATE_PROGRAM:
+            programs[reader.read32()] = glCreateProgram();
+            break;
+        case GL_TRACE_ATTACH_SHADER: {
+            unsigned int program = reader.read32();
+            glAttachShader(mapName(programs, program), mapName(shaders, reader.read32()));
+            break;
+        }
+        case GL_TRACE_LINK_PROGRAM:
+            glLinkProgram(mapName(programs, reader.read32()));
+            break;
+        case GL_TRACE_VALIDATE_PROGRAM:
+            glValidateProgram(mapName(programs, reader.read32()));
+            break;
+        case GL_TRACE_DELETE_PROGRAM: {
+            unsigned int program = reader.read32();
+            glDeleteProgram(mapName(programs, program));
+            programs.erase(program);
+            break;
+        }
+        case GL_TRACE_USE_PROGRAM:
+            currentProgram = reader.read32();
+            glUseProgram(mapName(programs, currentProgram));
+            break;
+        case GL_TRACE_GET_UNIFORM_LOCATION: {
+            unsigned int program = reader.read32();
+            const GLchar* name = (const GLchar*) reader.readPayload(size);
+            int32_t location = reader.readInt();
+            uniformLocations[((uint64_t) program << 32) | (uint32_t) location] = glGetUniformLocation(mapName(programs, program), name);
+            break;
+        }
+        case GL_TRACE_UNIFORM_1I: {
+            GLint location = reader.readInt();
+            glUniform1i(getUniformLocation(location), reader.readInt());
+            break;
+        }
+        case GL_TRACE_UNIFORM_1F: {
+            GLint location = reader.readInt();
+            glUniform1f(getUniformLocation(location), reader.readFloat());
+            break;
+        }
+        case GL_TRACE_UNIFORM_4F: {
+            GLint location = reader.readInt();
+            float v0 = reader.readFloat();
+            float v1 = reader.readFloat();
+            float v2 = reader.readFloat();
+            float v3 = reader.readFloat();
+            glUniform4f(getUniformLocation(location), v0, v1, v2, v3);
+            break;
+        }
+        case GL_TRACE_UNIFORM_1IV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform1iv(getUniformLocation(location), count, (const GLint*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_4FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform4fv(getUniformLocation(location), count, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_4FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix4fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_1FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform1fv(getUniformLocation(location), count, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_2FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform2fv(getUniformLocation(location), count, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_3FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform3fv(getUniformLocation(location), count, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_2IV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform2iv(getUniformLocation(location), count, (const GLint*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_3IV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform3iv(getUniformLocation(location), count, (const GLint*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_4IV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform4iv(getUniformLocation(location), count, (const GLint*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_1UIV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform1uiv(getUniformLocation(location), count, (const GLuint*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_2UIV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform2uiv(getUniformLocation(location), count, (const GLuint*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_3UIV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform3uiv(getUniformLocation(location), count, (const GLuint*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_4UIV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform4uiv(getUniformLocation(location), count, (const GLuint*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_2FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix2fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_3FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix3fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_2X3FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix2x3fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_2X4FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix2x4fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_3X2FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix3x2fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_3X4FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix3x4fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_4X2FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix4x2fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_4X3FV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix4x3fv(getUniformLocation(location), count, transpose, (const GLfloat*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_1DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform1dv(getUniformLocation(location), count, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_2DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform2dv(getUniformLocation(location), count, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_3DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform3dv(getUniformLocation(location), count, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_4DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            glUniform4dv(getUniformLocation(location), count, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_2DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix2dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_3DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix3dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_4DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix4dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_2X3DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix2x3dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_2X4DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix2x4dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_3X2DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix3x2dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_3X4DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix3x4dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_4X2DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix4x2dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_MATRIX_4X3DV: {
+            GLint location = reader.readInt();
+            GLsizei count = reader.readInt();
+            GLboolean transpose = (GLboolean) reader.read32();
+            glUniformMatrix4x3dv(getUniformLocation(location), count, transpose, (const GLdouble*) reader.readPayload(size));
+            break;
+        }
+        case GL_TRACE_UNIFORM_BLOCK_BINDING: {
+            unsigned int program = reader.read32();
+            GLuint index = reader.read32();
+            glUniformBlockBinding(mapName(programs, program), index, reader.read32());
+            break;
+        }
+
+        case GL_TRACE_GEN_FRAMEBUFFERS:
+            genNames(framebuffers, reader, glGenFramebuffers);
+            break;
+        case GL_TRACE_DELETE_FRAMEBUFFERS:
+            deleteNames(framebuffers, reader, glDeleteFramebuffers);
+            break;
+        case GL_TRACE_BIND_FRAMEBUFFER: {
+            GLenum target = reader.read32();
+            unsigned int framebuffer = reader.read32();
+            glBindFramebuffer(target, framebuffer == 0 ? defaultFramebuffer : mapName(framebuffers, framebuffer));
+            break;
+        }
+        case GL_TRACE_GEN_RENDERBUFFERS:
+            genNames(renderbuffers, reader, glGenRenderbuffers);
+            break;
+        case GL_TRACE_DELETE_RENDERBUFFERS:
+            deleteNames(renderbuffers, reader, glDeleteRenderbuffers);
+            break;
+        case GL_TRACE_BIND_RENDERBUFFER: {
+            GLenum target = reader.read32();
+            glBindRenderbuffer(target, mapName(renderbuffers, reader.read32()));
+            break;
+        }
+        case GL_TRACE_RENDERBUFFER_STORAGE: {
+            GLenum target = reader.read32();
+            GLenum format = reader.read32();
+            GLsizei width = reader.readInt();
+            glRenderbufferStorage(target, format, width, reader.readInt());
+            break;
+        }
+        case GL_TRACE_FRAMEBUFFER_RENDERBUFFER: {
+            GLenum target = reader.read32();
+            GLenum attachment = reader.read32();
+            GLenum renderbufferTarget = reader.read32();
+            glFramebufferRenderbuffer(target, attachment, renderbufferTarget, mapName(renderbuffers, reader.read32()));
+            break;
+        }
+
+        case GL_TRACE_ACTIVE_TEXTURE:
+            glActiveTexture(reader.read32());
+            break;
+        case GL_TRACE_BIND_TEXTURE: {
+            //NOTE: We don't capture texture creation yet, so texture names are used as they were.
+            GLenum target = reader.read32();
+            glBindTexture(target, reader.read32());
+            break;
+        }
+
+        case GL_TRACE_CLEAR:
+            glClear(reader.read32());
+            break;
+        case GL_TRACE_CLEAR_COLOR: {
+            float red = reader.readFloat();
+            float green = reader.readFloat();
+            float blue = reader.readFloat();
+            glClearColor(red, green, blue, reader.readFloat());
+            break;
+        }
+        case GL_TRACE_VIEWPORT: {
+            GLint x = reader.readInt();
+            GLint y = reader.readInt();
+            GLsizei width = reader.readInt();
+            glViewport(x, y, width, reader.readInt());
+            break;
+        }
+        case GL_TRACE_ENABLE:
+            glEnable(reader.read32());
+            break;
+        case GL_TRACE_DISABLE:
+            glDisable(reader.read32());
+            break;
+        case GL_TRACE_PIXEL_STOREI: {
+            GLenum name = reader.read32();
+            glPixelStorei(name, reader.readInt());
+            break;
+        }
+
+        case GL_TRACE_DRAW_ELEMENTS: {
+            GLenum mode = reader.read32();
+            GLsizei count = reader.readInt();
+            GLenum type = reader.read32();
+            glDrawElements(mode, count, type, (const void*) (uintptr_t) reader.read64());
+            break;
+        }
+        case GL_TRACE_DRAW_ELEMENTS_INSTANCED: {
+            GLenum mode = reader.read32();
+            GLsizei count = reader.readInt();
+            GLenum type = reader.read32();
+            const void* offset = (const void*) (uintptr_t) reader.read64();
+            glDrawElementsInstanced(mode, count, type, offset, reader.readInt());
+            break;
+        }
+        case GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_INSTANCE: {
+            GLenum mode = reader.read32();
+            GLsizei count = reader.readInt();
+            GLenum type = reader.read32();
+            const void* offset = (const void*) (uintptr_t) reader.read64();
+            GLsizei instanceCount = reader.readInt();
+            glDrawElementsInstancedBaseInstance(mode, count, type, offset, instanceCount, reader.read32());
+            break;
+        }
+        case GL_TRACE_DRAW_ELEMENTS_BASE_VERTEX: {
+            GLenum mode = reader.read32();
+            GLsizei count = reader.readInt();
+            GLenum type = reader.read32();
+            void* offset = (void*) (uintptr_t) reader.read64();
+            glDrawElementsBaseVertex(mode, count, type, offset, reader.readInt());
+            break;
+        }
+        case GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX: {
+            GLenum mode = reader.read32();
+            GLsizei count = reader.readInt();
+            GLenum type = reader.read32();
+            const void* offset = (const void*) (uintptr_t) reader.read64();
+            GLsizei instanceCount = reader.readInt();
+            glDrawElementsInstancedBaseVertex(mode, count, type, offset, instanceCount, reader.readInt());
+            break;
+        }
+        case GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE: {
+            GLenum mode = reader.read32();
+            GLsizei count = reader.readInt();
+            GLenum type = reader.read32();
+            const void* offset = (const void*) (uintptr_t) reader.read64();
+            GLsizei instanceCount = reader.readInt();
+            GLint baseVertex = reader.readInt();
+            glDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, offset, instanceCount, baseVertex, reader.read32());
+            break;
+        }
+        case GL_TRACE_MULTI_DRAW_ELEMENTS_BASE_VERTEX: {
+            GLenum mode = reader.read32();
+            GLenum type = reader.read32();
+            GLsizei drawCount = reader.readInt();
+            uint32_t countsSize;
+            uint32_t offsetsSize;
+            uint32_t baseVerticesSize;
+            const void* capturedCounts = reader.readPayload(countsSize);
+            const char* capturedOffsets = (const char*) reader.readPayload(offsetsSize);
+            const void* capturedBaseVertices = reader.readPayload(baseVerticesSize);
+            if (drawCount < 0 || countsSize < drawCount * sizeof(GLsizei) || offsetsSize < drawCount * sizeof(uint64_t) || baseVerticesSize < drawCount * sizeof(GLint)) {
+                cout << "Multi-draw at byte " << position << " has fewer draws than it says! Skipping it." << endl;
+                break;
+            }
+
+            vector<GLsizei> counts = vector<GLsizei>(drawCount);
+            vector<void*> offsets = vector<void*>(drawCount);
+            vector<GLint> baseVertices = vector<GLint>(drawCount);
+
+            //NOTE: Copied out, since the payloads aren't aligned (and offsets need converting back to pointers).
+            memcpy(counts.data(), capturedCounts, drawCount * sizeof(GLsizei));
+            for (GLsizei i = 0; i < drawCount; i++) {
+                uint64_t offset;
+                memcpy(&offset, capturedOffsets + i * sizeof(uint64_t), sizeof(uint64_t));
+                offsets[i] = (void*) (uintptr_t) offset;
+            }
+            memcpy(baseVertices.data(), capturedBaseVertices, drawCount * sizeof(GLint));
+            glMultiDrawElementsBaseVertex(mode, counts.data(), type, offsets.data(), drawCount, baseVertices.data());
+            break;
+        }
+        case GL_TRACE_MULTI_DRAW_ELEMENTS_INDIRECT: {
+            GLenum mode = reader.read32();
+            GLenum type = reader.read32();
+            const void* offset = (const void*) (uintptr_t) reader.read64();
+            GLsizei drawCount = reader.readInt();
+            glMultiDrawElementsIndirect(mode, type, offset, drawCount, reader.readInt());
+            break;
+        }
+
+        case GL_TRACE_FENCE_SYNC: {
+            GLenum condition = reader.read32();
+            GLbitfield flags = reader.read32();
+            uint64_t captured = reader.read64();
+
+            //NOTE: When we loop over the frames, a fence from the last time around might never have been waited on (and deleted).
+            unordered_map<uint64_t, GLsync>::iterator it = syncs.find(captured);
+            if (it != syncs.end())
+                glDeleteSync(it->second);
+            syncs[captured] = glFenceSync(condition, flags);
+            break;
+        }
+        case GL_TRACE_CLIENT_WAIT_SYNC: {
+            unordered_map<uint64_t, GLsync>::iterator it = syncs.find(reader.read64());
+            GLbitfield flags = reader.read32();
+            GLuint64 timeout = reader.read64();
+            if (it != syncs.end())
+                glClientWaitSync(it->second, flags, timeout);
+            break;
+        }
+        case GL_TRACE_DELETE_SYNC: {
+            unordered_map<uint64_t, GLsync>::iterator it = syncs.find(reader.read64());
+            if (it != syncs.end()) {
+                glDeleteSync(it->second);
+                syncs.erase(it);
+            }
+            break;
+        }
+        case GL_TRACE_FLUSH:
+            glFlush();
+            break;
+        case GL_TRACE_FINISH:
+            glFinish();
+            break;
+
+        default:
+            //From a newer trace version, most likely. The record's size lets us skip it.
+            break;
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <GL/glew.h>
+
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+/// <summary>
+/// Re-runs the OpenGL calls from a GL trace (see GLTrace in OpenGLBasics), with nothing but the calls themselves in the way.
+/// The setup (the first frame, along with everything before it) runs once, then each frame can be replayed as many times as you like.
+/// </summary>
+//NOTE: OpenGL can hand out different names for our objects than it did while capturing, so we map every captured name to ours as we go.
+//      Anything the trace draws to the default framebuffer goes to the one passed to setDefaultFramebuffer() instead, since we may not have a window.
+class TraceReplayer {
+    private:
+    //A record in the trace, read front to back.
+    //NOTE: Never reads past end. Reading past it instead gives 0 (or a null payload) and marks the reader as failed, since the record must be corrupt.
+    class Reader {
+        private:
+        const char* data;
+        const char* end;
+        bool failed;
+
+        public:
+        Reader(const char* data, const char* end);
+
+        inline bool hasFailed() const { return failed; }
+
+        uint32_t read32();
+        int32_t readInt();
+        uint64_t read64();
+        float readFloat();
+
+        /// <summary>
+        /// Returns a pointer into the trace (or nullptr for a null pointer), and skips past the payload.
+        /// </summary>
+        const void* readPayload(uint32_t& size);
+
+        //Whether there are size more bytes to read, failing if not. Check counts with it before allocating for them.
+        bool canRead(size_t size);
+    };
+
+    //A buffer range the trace mapped, so we can put its mapped writes where they belong.
+    struct Mapping {
+        char* pointer;
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    vector<char> trace;
+    size_t setupEnd; //Setup is everything up to the end of the first frame, since that's also when everything gets created
+    vector<std::pair<size_t, size_t>> frames; //Start and end of each frame in trace
+
+    unordered_map<unsigned int, unsigned int> buffers;
+    unordered_map<unsigned int, unsigned int> vertexArrays;
+    unordered_map<unsigned int, unsigned int> shaders;
+    unordered_map<unsigned int, unsigned int> programs;
+    unordered_map<unsigned int, unsigned int> framebuffers;
+    unordered_map<unsigned int, unsigned int> renderbuffers;
+    unordered_map<uint64_t, int> uniformLocations; //(captured program << 32 | captured location) => location
+    unordered_map<uint64_t, GLsync> syncs;
+    unsigned int defaultFramebuffer;
+    unsigned int currentProgram; //Captured name
+
+    //Captured buffer bound to each target, so we know which buffer a glMapBufferRange maps.
+    unordered_map<unsigned int, unsigned int> boundBuffers;
+    unordered_map<unsigned int, Mapping> mappings; //Captured buffer => where it's mapped
+
+    public:
+    TraceReplayer();
+
+    bool load(const string& filePath);
+
+    //NOTE: Not counting the first frame, which is part of the setup.
+    inline unsigned int getFrameCount() const { return (unsigned int) frames.size(); }
+    inline size_t getSize() const { return trace.size(); }
+
+    void setDefaultFramebuffer(unsigned int framebuffer);
+
+    void replaySetup();
+    void replayFrame(unsigned int index);
+
+    private:
+    void replay(size_t start, size_t end);
+    void replayRecord(uint8_t op, Reader& reader, size_t position);
+
+    //Maps a captured location in the current program.
+    int getUniformLocation(int captured) const;
+    static unsigned int mapName(const unordered_map<unsigned int, unsigned int>& names, unsigned int captured);
+    void genNames(unordered_map<unsigned int, unsigned int>& names, Reader& reader, void (GLAPIENTRY *gen)(GLsizei, GLuint*));
+    void deleteNames(unordered_map<unsigned int, unsigned int>& names, Reader& reader, void (GLAPIENTRY *del)(GLsizei, const GLuint*));
+};
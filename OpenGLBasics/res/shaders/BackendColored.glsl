@@ -0,0 +1,23 @@
+#shader vertex
+#version 330 core
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec4 color;
+
+out vec4 v_Color;
+
+void main() {
+   v_Color = color;
+   gl_Position = vec4(position, 0, 1);
+};
+
+#shader fragment
+#version 330 core
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+#include "include/FrameConstants.glsl"
+
+void main() {
+   color = v_Color * u_Frame[0];
+};
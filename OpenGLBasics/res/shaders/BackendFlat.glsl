@@ -0,0 +1,18 @@
+#shader vertex
+#version 330 core
+layout(location = 0) in vec2 position;
+
+void main() {
+   gl_Position = vec4(position, 0, 1);
+};
+
+#shader fragment
+#version 330 core
+layout(location = 0) out vec4 color;
+
+//Set per draw (see RenderBackend). [0] is the color.
+uniform vec4 u_Draw[4];
+
+void main() {
+   color = u_Draw[0];
+};
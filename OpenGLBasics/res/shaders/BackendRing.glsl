@@ -0,0 +1,28 @@
+#shader vertex
+#version 330 core
+layout(location = 0) in vec2 position;
+
+#include "include/FrameConstants.glsl"
+
+//Set per draw. [0].xy is where this quad sits on the ring, and [1] is its color.
+uniform vec4 u_Draw[4];
+
+void main() {
+   //Spin the whole ring around the center over time
+   float s = sin(u_Frame[1].x * 0.5);
+   float c = cos(u_Frame[1].x * 0.5);
+   vec2 offset = u_Draw[0].xy;
+   vec2 rotatedOffset = vec2(offset.x * c - offset.y * s, offset.x * s + offset.y * c);
+
+   gl_Position = vec4(position * 0.1 + rotatedOffset, 0, 1);
+};
+
+#shader fragment
+#version 330 core
+layout(location = 0) out vec4 color;
+
+uniform vec4 u_Draw[4];
+
+void main() {
+   color = u_Draw[1];
+};
@@ -0,0 +1,53 @@
+//Batches with no textured quads in them skip sampling entirely (see BatchRenderer).
+#pragma variant TEXTURED
+
+#shader vertex
+#version 330 core
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in float texIndex;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out float v_TexIndex;
+
+void main() {
+   v_Color = color;
+   v_TexCoord = texCoord;
+   v_TexIndex = texIndex;
+   gl_Position = vec4(position, 0, 1);
+};
+
+#shader fragment
+#version 330 core
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in float v_TexIndex;
+
+#include "include/Frame.glsl"
+
+#ifdef TEXTURED
+//NOTE: Must match BatchRenderer::MAX_TEXTURE_SLOTS.
+uniform sampler2D u_Textures[8];
+#endif
+
+void main() {
+   vec4 texColor = vec4(1.0);
+#ifdef TEXTURED
+   //GLSL 330 only lets us index sampler arrays with constants, hence the switch.
+   switch (int(v_TexIndex)) {
+      case 0: texColor = texture(u_Textures[0], v_TexCoord); break;
+      case 1: texColor = texture(u_Textures[1], v_TexCoord); break;
+      case 2: texColor = texture(u_Textures[2], v_TexCoord); break;
+      case 3: texColor = texture(u_Textures[3], v_TexCoord); break;
+      case 4: texColor = texture(u_Textures[4], v_TexCoord); break;
+      case 5: texColor = texture(u_Textures[5], v_TexCoord); break;
+      case 6: texColor = texture(u_Textures[6], v_TexCoord); break;
+      case 7: texColor = texture(u_Textures[7], v_TexCoord); break;
+   }
+#endif
+   color = texColor * v_Color * u_Tint;
+};
@@ -0,0 +1,16 @@
+#shader vertex
+#version 330 core
+layout(location = 0) in vec4 position;
+
+void main() {
+   gl_Position = position;
+};
+
+#shader fragment
+#version 330 core
+layout(location = 0) out vec4 color;
+
+//Drawn in place of shaders that are still compiling (see Renderer::setFallbackShader), so it's hard to miss.
+void main() {
+   color = vec4(1, 0, 1, 1);
+};
@@ -0,0 +1,31 @@
+#shader vertex
+#version 330 core
+layout(location = 0) in vec4 position;
+
+//Per-instance attributes (divisor 1)
+layout(location = 1) in vec2 offset;
+layout(location = 2) in vec4 instanceColor;
+
+out vec4 v_Color;
+
+#include "include/Frame.glsl"
+
+void main() {
+   //Spin the whole ring around the center over time
+   float s = sin(u_Time * 0.5);
+   float c = cos(u_Time * 0.5);
+   vec2 rotatedOffset = vec2(offset.x * c - offset.y * s, offset.x * s + offset.y * c);
+
+   v_Color = instanceColor;
+   gl_Position = vec4(position.xy * 0.1 + rotatedOffset, 0, 1);
+};
+
+#shader fragment
+#version 330 core
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main() {
+   color = v_Color;
+};
@@ -0,0 +1,5 @@
+//Shared by every program that declares it, and uploaded once per frame (see UniformBuffer)
+layout(std140) uniform Frame {
+   vec4 u_Tint;
+   float u_Time;
+};
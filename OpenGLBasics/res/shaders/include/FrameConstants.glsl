@@ -0,0 +1,4 @@
+//Set once per frame (see RenderBackend). [0] is the tint, and [1].x is the time.
+layout(std140) uniform FrameConstants {
+   vec4 u_Frame[4];
+};
@@ -1,24 +1,197 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
-#include "IndexBuffer.h"
-#include "Renderer.h"
-#include "Shader.h"
-#include "VertexArray.h"
-#include "VertexBuffer.h"
+#include "BackendDemoScene.h"
+#include "Benchmark.h"
+#include "CpuProfiler.h"
+#include "DemoScene.h"
+#include "FrameLimiter.h"
+#include "Framebuffer.h"
+#include "GLBackend.h"
+#include "GLStateCache.h"
+#include "GLTrace.h"
+#include "HeadlessContext.h"
+#include "NullGL.h"
+#include "OpenGLUtil.h"
+#include "RecordingBenchmark.h"
+#include "RedrawTracker.h"
+#include "RenderStats.h"
+#include "ShaderCache.h"
+#include "SoftwareBackend.h"
 
 using std::cout;
 using std::endl;
+using std::string;
+using std::vector;
+
+struct AppOptions {
+    bool headless;
+    unsigned int frameCount;    //Headless or benchmark only: how many frames to render (or measure) before exiting
+    int width;
+    int height;
+    string outputPath;          //Headless only: where to save the last frame (as a .ppm), if anywhere
+
+    bool benchmark;             //Uncapped (no vsync), timing every frame
+    unsigned int warmupFrames;
+    string csvPath;             //Benchmark only: where to write per-frame timings, if anywhere
+    string jsonPath;            //Benchmark only: where to write the summary, if anywhere
+
+    string tracePath;           //Where to write a Chrome trace of the CPU profiler's scopes when we exit, if anywhere
+
+    bool noError;               //Create a KHR_no_error context, for release runs where we trust our calls (and want OpenGL to skip checking them)
+
+    string capturePath;         //Where to capture every GL call we make (see GLTrace), to replay with GLReplay, if anywhere
+
+    unsigned int statsInterval; //Log the render stats (see RenderStats) every this many frames, or never with 0
+
+    bool nullGL;                //Headless, without any context: every GL call goes nowhere (see NullGL), to measure our own CPU overhead
+
+    string backend;             //Headless: render the demo through this RenderBackend ("gl" or "software") instead, if any
+
+    unsigned int framesInFlight; //Most frames the CPU can get ahead of the GPU (see FrameLimiter), from 1 to 3, or 0 to leave it up to the driver
+
+    bool onDemand;              //Windowed only: only redraw when something changed (see RedrawTracker), sleeping until an event otherwise
+
+    string shaderCachePath;     //Where to keep linked program binaries between runs (see ShaderCache), or "" to always compile
+
+    bool asyncShaders;          //Compile the demo's shaders in the background, drawing with a fallback until they're ready (see ShaderCompileMode)
+
+    int recordThreads;          //Headless: instead of the demo, time recording draws on 1 thread vs this many (0 for one per core, see RecordingBenchmark), or -1 not to
+};
+
+//NOTE: How long an on-demand window sleeps at most without any events, so it still wakes up to notice changes that don't come from events.
+static const double ON_DEMAND_WAKEUP_SECONDS = 1.0;
+
+AppOptions parseOptions(int argc, char** argv);
+int runWindowed(const AppOptions& options);
+void installRedrawCallbacks(GLFWwindow* window, bool* animating);
+int runHeadless(const AppOptions& options);
+int runBackend(const AppOptions& options);
+int runRecordingBenchmark(const AppOptions& options);
+bool initGlew();
+void initErrorChecking(const AppOptions& options);
+std::unique_ptr<FrameLimiter> createFrameLimiter(const AppOptions& options);
+void reportBenchmark(Benchmark& benchmark, const AppOptions& options);
+void printStateCacheStats();
+void writeTrace(const AppOptions& options);
+bool writePpm(const string& filePath, int width, int height, const vector<unsigned char>& rgba);
 
 /// <summary>
 /// An example of drawing a triangle using legacy OpenGL 1.0, which didn't require glew.
 /// </summary>
 void drawLegacyTriangle();
 
-int main() {
+int main(int argc, char** argv) {
+    AppOptions options = parseOptions(argc, argv);
+    RenderStats::get().setLogInterval(options.statsInterval);
+    ShaderCache::get().setDirectory(options.shaderCachePath);
+    CpuProfiler::setEnabled(!options.tracePath.empty());
+    if (!options.backend.empty())
+        return runBackend(options);
+    if (options.headless)
+        return runHeadless(options);
+    return runWindowed(options);
+}
+
+AppOptions parseOptions(int argc, char** argv) {
+    AppOptions options = {
+        false,
+        100,
+        640,
+        480,
+        "",
+        false,
+        60,
+        "",
+        "",
+        "",
+        false,
+        "",
+        0,
+        false,
+        "",
+        0,
+        false,
+        "shadercache",
+        false,
+        -1
+    };
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--headless") == 0)
+            options.headless = true;
+        else if (strcmp(argv[i], "--frames") == 0 && hasValue)
+            options.frameCount = (unsigned int) atoi(argv[++i]);
+        else if (strcmp(argv[i], "--width") == 0 && hasValue) {
+            int width = atoi(argv[++i]);
+            if (width > 0)
+                options.width = width;
+            else
+                cout << "Ignoring --width " << argv[i] << ", it needs to be a positive number." << endl;
+        }
+        else if (strcmp(argv[i], "--height") == 0 && hasValue) {
+            int height = atoi(argv[++i]);
+            if (height > 0)
+                options.height = height;
+            else
+                cout << "Ignoring --height " << argv[i] << ", it needs to be a positive number." << endl;
+        }
+        else if (strcmp(argv[i], "--output") == 0 && hasValue)
+            options.outputPath = argv[++i];
+        else if (strcmp(argv[i], "--benchmark") == 0)
+            options.benchmark = true;
+        else if (strcmp(argv[i], "--warmup") == 0 && hasValue)
+            options.warmupFrames = (unsigned int) atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && hasValue)
+            options.csvPath = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && hasValue)
+            options.jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--trace") == 0 && hasValue)
+            options.tracePath = argv[++i];
+        else if (strcmp(argv[i], "--no-error") == 0)
+            options.noError = true;
+        else if (strcmp(argv[i], "--capture") == 0 && hasValue)
+            options.capturePath = argv[++i];
+        else if (strcmp(argv[i], "--stats-interval") == 0 && hasValue)
+            options.statsInterval = (unsigned int) atoi(argv[++i]);
+        else if (strcmp(argv[i], "--null-gl") == 0)
+            options.headless = options.nullGL = true;
+        else if (strcmp(argv[i], "--backend") == 0 && hasValue)
+            options.backend = argv[++i];
+        else if (strcmp(argv[i], "--software") == 0)
+            options.backend = "software";
+        else if (strcmp(argv[i], "--frames-in-flight") == 0 && hasValue)
+            options.framesInFlight = (unsigned int) atoi(argv[++i]);
+        else if (strcmp(argv[i], "--on-demand") == 0)
+            options.onDemand = true;
+        else if (strcmp(argv[i], "--shader-cache") == 0 && hasValue)
+            options.shaderCachePath = argv[++i];
+        else if (strcmp(argv[i], "--no-shader-cache") == 0)
+            options.shaderCachePath = "";
+        else if (strcmp(argv[i], "--async-shaders") == 0)
+            options.asyncShaders = true;
+        else if (strcmp(argv[i], "--record-threads") == 0 && hasValue) {
+            options.headless = true;
+            options.recordThreads = std::max(atoi(argv[++i]), 0);
+        }
+        else
+            cout << "Ignoring unknown option: " << argv[i] << endl;
+    }
+    return options;
+}
+
+int runWindowed(const AppOptions& options) {
     //Initialize the library
     if (!glfwInit())
         return -1;
@@ -28,6 +201,10 @@ int main() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); //As opposed to GLFW_OPENGL_COMPAT_PROFILE
 
+    //NOTE: A context can't be both no-error and debug.
+    glfwWindowHint(GLFW_CONTEXT_NO_ERROR, options.noError ? GLFW_TRUE : GLFW_FALSE);
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, !options.noError && glWantsDebugContext() ? GLFW_TRUE : GLFW_FALSE);
+
     //NOTE: See the following for OpenGL Core vs. Compatibility context:
     //  https://www.reddit.com/r/opengl/comments/aln1jt/what_is_difference_between_core_profile_and/
     //  https://www.khronos.org/opengl/wiki/OpenGL_Context
@@ -37,7 +214,7 @@ int main() {
     //      In core, you would need to create & bind one first, or else you'll receive OpenGL error 1282 (invalid operation) for glEnableVertexAttribArray(...).
 
     //Create a windowed mode window and its OpenGL context
-    GLFWwindow* window = glfwCreateWindow(640, 480, "Hello World", NULL, NULL);
+    GLFWwindow* window = glfwCreateWindow(options.width, options.height, "Hello World", NULL, NULL);
     if (window == NULL) {
         glfwTerminate();
         return -1;
@@ -47,81 +224,362 @@ int main() {
     glfwMakeContextCurrent(window);
 
     //Important for making our framerate steady.. (VSync?)
-    glfwSwapInterval(1);
+    //NOTE: Benchmarks run uncapped, since vsync would hide how long our frames actually take.
+    glfwSwapInterval(options.benchmark ? 0 : 1);
 
     //NOTE: This requires a valid rendering context first
-    if (glewInit() != GLEW_OK)
+    if (!initGlew())
+        return -1;
+    initErrorChecking(options);
+    if (!options.capturePath.empty() && !GLTrace::beginCapture(options.capturePath))
         return -1;
 
     cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
 
     {
-        const int POSITION_COUNT = 8;
-        float positions[POSITION_COUNT] = {
-            0.5f,   -0.5f,
-            -0.5f,  -0.5f,
-            0.5f,   0.5f,
-            -0.5f,  0.5f
-        };
-
-        const int INDEX_COUNT = 6;
-        unsigned int indices[INDEX_COUNT] = {
-            0, 1, 2,
-            3, 2, 1
-        };
-
-        VertexArray va;
-        VertexBuffer vb = VertexBuffer(positions, POSITION_COUNT * sizeof(float));
-        VertexBufferLayout layout;
-        layout.push<float>(2);
-        va.addBuffer(vb, layout);
-
-        IndexBuffer ib = IndexBuffer(indices, INDEX_COUNT);
-
-        Shader shader = Shader("res/shaders/Basic.glsl");
-        shader.bind();
-        shader.setUniform4f("uniColor", 0.2f, 0.6f, 0.8f, 1);
-
-        float r = 0;
-        float increment = 0.05f;
-
-        //Unbind everything, just to demonstrate
-        va.unbind();
-        vb.unbind();
-        ib.unbind();
-        shader.unbind();
-
-        Renderer renderer;
-
-        //Loop until the user closes the window
-        while (!glfwWindowShouldClose(window)) {
-            //Render here
-            renderer.clear();
-
-            //Rebind everything
-            shader.bind();
-            shader.setUniform4f("uniColor", r, 0.6f, 0.8f, 1);
-
-            renderer.draw(va, ib, shader);
-
-            if (r > 1)
-                increment = -0.05f;
-            else if (r < 0)
-                increment = 0.05f;
-            r += increment;
-
-            //Swap front and back buffers
-            glfwSwapBuffers(window);
-
-            //Poll for and process events
-            glfwPollEvents();
+        DemoScene scene(options.asyncShaders ? ShaderCompileMode::ASYNC : ShaderCompileMode::BLOCKING);
+        std::unique_ptr<FrameLimiter> limiter = createFrameLimiter(options);
+
+        if (options.benchmark) {
+            Benchmark benchmark(options.warmupFrames, options.frameCount);
+            for (unsigned int frame = 0; !benchmark.isDone() && !glfwWindowShouldClose(window); frame++) {
+                PROFILE_SCOPE("Frame");
+                benchmark.beginFrame();
+                scene.render(frame / 60.0f);
+                benchmark.endSubmit();
+                GLTrace::endFrame();
+                RenderStats::get().endFrame();
+                glfwSwapBuffers(window);
+                if (limiter) {
+                    limiter->endFrame();
+                    benchmark.addWaitTime(limiter->getLastWaitTime());
+                }
+                benchmark.endFrame();
+                glfwPollEvents();
+            }
+            reportBenchmark(benchmark, options);
+        } else {
+            //NOTE: On demand, the animation only plays while toggled on (with space), so the scene stays still (and we stay asleep) otherwise.
+            RedrawTracker& redrawTracker = RedrawTracker::get();
+            bool animating = false;
+            double animationTime = 0;
+            double lastTime = glfwGetTime();
+            if (options.onDemand)
+                installRedrawCallbacks(window, &animating);
+
+            //Loop until the user closes the window
+            while (!glfwWindowShouldClose(window)) {
+                if (options.onDemand && !redrawTracker.needsRedraw()) {
+                    redrawTracker.onIdleWakeup();
+                } else {
+                    PROFILE_SCOPE("Frame");
+
+                    //Render here
+                    scene.render(options.onDemand ? (float) animationTime : (float) glfwGetTime());
+                    GLTrace::endFrame();
+                    RenderStats::get().endFrame();
+
+                    //Swap front and back buffers
+                    glfwSwapBuffers(window);
+                    if (limiter)
+                        limiter->endFrame();
+                    redrawTracker.onFrameRendered();
+                }
+
+                //Poll for and process events
+                if (!options.onDemand) {
+                    glfwPollEvents();
+                    continue;
+                }
+                double now = glfwGetTime();
+                if (animating) {
+                    animationTime += now - lastTime;
+                    redrawTracker.invalidate();
+                }
+                lastTime = now;
+
+                //There's already another frame to draw, so don't wait for events
+                if (redrawTracker.needsRedraw())
+                    glfwPollEvents();
+                else
+                    glfwWaitEventsTimeout(ON_DEMAND_WAKEUP_SECONDS);
+            }
+            if (options.onDemand)
+                redrawTracker.print();
         }
+
+        GLTrace::endCapture();
+        printStateCacheStats();
+        ShaderCache::get().print();
+        if (limiter)
+            limiter->print();
+        writeTrace(options);
     } //Delete our stack-allocated data BEFORE terminating GLFW/OpenGL context, so everything we were using is cleaned up first.
 
     glfwTerminate();
     return 0;
 }
 
+int runHeadless(const AppOptions& options) {
+    //NOTE: Declared first, so it outlives everything using it.
+    std::unique_ptr<HeadlessContext> context;
+    if (options.nullGL) {
+        NullGL::install();
+    } else {
+        context.reset(new HeadlessContext(options.noError));
+        if (!context->isValid()) {
+            cout << "Failed to create a headless OpenGL context!" << endl;
+            return -1;
+        }
+        if (!initGlew())
+            return -1;
+        initErrorChecking(options);
+    }
+    if (!options.capturePath.empty() && !GLTrace::beginCapture(options.capturePath))
+        return -1;
+
+    cout << "Headless context: " << (context ? context->getBackendName() : "none (Null GL)") << endl;
+    cout << "OpenGL Version: " << glGetString(GL_VERSION) << endl;
+    cout << "OpenGL Renderer: " << glGetString(GL_RENDERER) << endl;
+
+    int result = 0;
+    {
+        Framebuffer framebuffer = Framebuffer(options.width, options.height);
+        framebuffer.bind();
+        if (options.recordThreads >= 0) {
+            result = runRecordingBenchmark(options);
+            GLTrace::endCapture();
+            writeTrace(options);
+            return result;
+        }
+
+        DemoScene scene(options.asyncShaders ? ShaderCompileMode::ASYNC : ShaderCompileMode::BLOCKING);
+        std::unique_ptr<FrameLimiter> limiter = createFrameLimiter(options);
+
+        //NOTE: Headless runs step time by a fixed 1/60th of a second per frame, so every run renders exactly the same frames.
+        if (options.benchmark) {
+            Benchmark benchmark(options.warmupFrames, options.frameCount);
+            for (unsigned int frame = 0; !benchmark.isDone(); frame++) {
+                PROFILE_SCOPE("Frame");
+                benchmark.beginFrame();
+                scene.render(frame / 60.0f);
+                benchmark.endSubmit();
+                GLTrace::endFrame();
+                RenderStats::get().endFrame();
+
+                //There's no swap to wait on, so make sure the GPU actually gets the frame's work before we time the next one.
+                glFlush();
+                if (limiter) {
+                    limiter->endFrame();
+                    benchmark.addWaitTime(limiter->getLastWaitTime());
+                }
+                benchmark.endFrame();
+            }
+            reportBenchmark(benchmark, options);
+        } else {
+            for (unsigned int frame = 0; frame < options.frameCount; frame++) {
+                PROFILE_SCOPE("Frame");
+                scene.render(frame / 60.0f);
+                GLTrace::endFrame();
+                RenderStats::get().endFrame();
+                if (limiter)
+                    limiter->endFrame();
+            }
+            cout << "Rendered " << options.frameCount << " frames." << endl;
+        }
+        glFinish();
+
+        GLTrace::endCapture();
+        printStateCacheStats();
+        ShaderCache::get().print();
+        if (limiter)
+            limiter->print();
+        if (NullGL::isInstalled())
+            NullGL::printCalls();
+        writeTrace(options);
+
+        if (!options.outputPath.empty() && NullGL::isInstalled()) {
+            cout << "Nothing was actually rendered with --null-gl, so there's no frame to save." << endl;
+        } else if (!options.outputPath.empty()) {
+            vector<unsigned char> pixels;
+            framebuffer.readPixels(pixels);
+            if (writePpm(options.outputPath, framebuffer.getWidth(), framebuffer.getHeight(), pixels))
+                cout << "Saved the last frame to " << options.outputPath << endl;
+            else
+                result = -1;
+        }
+    } //Again, clean up everything before the context goes away.
+
+    return result;
+}
+
+int runBackend(const AppOptions& options) {
+    //NOTE: Declared first, so they outlive everything using them.
+    std::unique_ptr<HeadlessContext> context;
+    std::unique_ptr<Framebuffer> framebuffer;
+    std::unique_ptr<RenderBackend> backend;
+    if (options.backend == "gl") {
+        context.reset(new HeadlessContext(options.noError));
+        if (!context->isValid()) {
+            cout << "Failed to create a headless OpenGL context!" << endl;
+            return -1;
+        }
+        if (!initGlew())
+            return -1;
+        initErrorChecking(options);
+        if (!options.capturePath.empty() && !GLTrace::beginCapture(options.capturePath))
+            return -1;
+        framebuffer.reset(new Framebuffer(options.width, options.height));
+        backend.reset(new GLBackend(*framebuffer));
+        cout << "Render backend: OpenGL " << glGetString(GL_VERSION) << endl;
+    } else if (options.backend == "software") {
+        SoftwareBackend* software = new SoftwareBackend(options.width, options.height);
+        backend.reset(software);
+        cout << "Render backend: software (" << SoftwareRasterizer::getSimdName() << ", " << software->getRasterizer().getThreadCount() << " threads)" << endl;
+    } else if (options.backend == "vulkan") {
+        cout << "There's no Vulkan backend yet (see the TODO in RenderBackend.h). Use gl or software." << endl;
+        return -1;
+    } else {
+        cout << "Unknown render backend: " << options.backend << " (use gl or software)" << endl;
+        return -1;
+    }
+
+    int result = 0;
+    {
+        BackendDemoScene scene(*backend);
+
+        //NOTE: Same fixed time step as the headless mode, so the frames match.
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned int frame = 0; frame < options.frameCount; frame++) {
+            PROFILE_SCOPE("Frame");
+            scene.render(frame / 60.0f);
+            GLTrace::endFrame();
+            RenderStats::get().endFrame();
+        }
+        if (context) {
+            glFinish();
+            GLTrace::endCapture();
+        }
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        cout << "Rendered " << options.frameCount << " frames in " << elapsed << " ms ("
+            << (options.frameCount > 0 ? elapsed / options.frameCount : 0) << " ms per frame)." << endl;
+
+        writeTrace(options);
+
+        if (!options.outputPath.empty()) {
+            vector<unsigned char> pixels;
+            backend->readPixels(pixels);
+            if (writePpm(options.outputPath, options.width, options.height, pixels))
+                cout << "Saved the last frame to " << options.outputPath << endl;
+            else
+                result = -1;
+        }
+    }
+    return result;
+}
+
+int runRecordingBenchmark(const AppOptions& options) {
+    if (!RecordingBenchmark::isSupported()) {
+        cout << "Recording benchmark needs OpenGL 4.2 (or ARB_base_instance), to draw each object as its own instance." << endl;
+        return -1;
+    }
+    RecordingBenchmark benchmark;
+    benchmark.run((unsigned int) options.recordThreads, options.warmupFrames, options.frameCount);
+    return 0;
+}
+
+bool initGlew() {
+    //NOTE: Without this, GLEW skips some entry points a core profile context does have.
+    glewExperimental = GL_TRUE;
+
+    GLenum result = glewInit();
+
+    //NOTE: On Linux, GLEW also tries to load GLX, which fails when there's no X server (e.g. our headless EGL context).
+    //      The OpenGL entry points themselves have already been loaded by then, so that's fine for us.
+    if (result != GLEW_OK && result != GLEW_ERROR_NO_GLX_DISPLAY) {
+        cout << "Failed to initialize GLEW: " << glewGetErrorString(result) << endl;
+        return false;
+    }
+    return true;
+}
+
+void initErrorChecking(const AppOptions& options) {
+    //NOTE: A no-error context doesn't report anything, so there's nothing to hook up, and GLCALL shouldn't ask either.
+    if (options.noError) {
+        cout << "Running without OpenGL error checking (KHR_no_error)." << endl;
+        glSetChecksEnabled(false);
+        return;
+    }
+    if (GL_CHECK_LEVEL == GL_CHECK_CALLBACK)
+        glInstallDebugCallback();
+}
+
+//NOTE: Anything that changes what the window shows (or needs it drawn again) has to invalidate the RedrawTracker.
+void installRedrawCallbacks(GLFWwindow* window, bool* animating) {
+    glfwSetWindowUserPointer(window, animating);
+    glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
+        if (key == GLFW_KEY_SPACE && action == GLFW_PRESS) {
+            bool* animating = (bool*) glfwGetWindowUserPointer(window);
+            *animating = !*animating;
+        }
+        RedrawTracker::get().invalidate();
+    });
+    glfwSetCursorPosCallback(window, [](GLFWwindow* window, double x, double y) { RedrawTracker::get().invalidate(); });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow* window, int button, int action, int mods) { RedrawTracker::get().invalidate(); });
+    glfwSetScrollCallback(window, [](GLFWwindow* window, double x, double y) { RedrawTracker::get().invalidate(); });
+    glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) { RedrawTracker::get().invalidate(); });
+
+    //When (part of) the window was covered or minimized and has to be drawn again
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* window) { RedrawTracker::get().invalidate(); });
+}
+
+std::unique_ptr<FrameLimiter> createFrameLimiter(const AppOptions& options) {
+    if (options.framesInFlight == 0)
+        return nullptr;
+    if (options.framesInFlight > FrameLimiter::MAX_FRAMES_IN_FLIGHT)
+        cout << "Can't have " << options.framesInFlight << " frames in flight, using " << FrameLimiter::MAX_FRAMES_IN_FLIGHT << " instead." << endl;
+    return std::unique_ptr<FrameLimiter>(new FrameLimiter(options.framesInFlight));
+}
+
+void reportBenchmark(Benchmark& benchmark, const AppOptions& options) {
+    benchmark.finish();
+    benchmark.printReport();
+    if (!options.csvPath.empty() && benchmark.writeCsv(options.csvPath))
+        cout << "Wrote per-frame timings to " << options.csvPath << endl;
+    if (!options.jsonPath.empty() && benchmark.writeJson(options.jsonPath))
+        cout << "Wrote the benchmark summary to " << options.jsonPath << endl;
+}
+
+void printStateCacheStats() {
+    GLStateCache& stateCache = GLStateCache::get();
+    cout << "GL state cache: skipped " << stateCache.getSkippedCalls() << " of "
+        << (stateCache.getIssuedCalls() + stateCache.getSkippedCalls()) << " bind calls." << endl;
+}
+
+void writeTrace(const AppOptions& options) {
+    if (!options.tracePath.empty() && CpuProfiler::writeChromeTrace(options.tracePath))
+        cout << "Wrote the CPU trace to " << options.tracePath << endl;
+}
+
+bool writePpm(const string& filePath, int width, int height, const vector<unsigned char>& rgba) {
+    std::ofstream stream = std::ofstream(filePath, std::ios::binary);
+    if (!stream) {
+        cout << "Failed to open " << filePath << " for writing!" << endl;
+        return false;
+    }
+
+    stream << "P6\n" << width << " " << height << "\n255\n";
+
+    //NOTE: OpenGL gives us the bottom row first, but PPM wants the top row first.
+    for (int y = height - 1; y >= 0; y--) {
+        for (int x = 0; x < width; x++) {
+            const unsigned char* pixel = &rgba[((size_t) y * width + x) * 4];
+            stream.write((const char*) pixel, 3);
+        }
+    }
+    return (bool) stream;
+}
+
 void drawLegacyTriangle() {
     glBegin(GL_TRIANGLES);
 
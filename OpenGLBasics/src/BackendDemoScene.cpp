@@ -0,0 +1,187 @@
+#include <cmath>
+#include <cstring>
+
+#include "BackendDemoScene.h"
+#include "DemoScene.h"
+
+//NOTE: Same as DemoScene's.
+static const float QUAD_POSITIONS[8] = {
+    0.5f,   -0.5f,
+    -0.5f,  -0.5f,
+    0.5f,   0.5f,
+    -0.5f,  0.5f
+};
+
+static const unsigned int QUAD_INDICES[6] = {
+    0, 1, 2,
+    3, 2, 1
+};
+
+//The uniforms a SoftwareBackend hands its shaders: the frame constants, then the draw constants (see RenderBackend).
+static inline const float* frameConstant(const float* uniforms, unsigned int index) {
+    return uniforms + index * 4;
+}
+
+static inline const float* drawConstant(const float* uniforms, unsigned int index) {
+    return uniforms + (BACKEND_CONSTANT_COUNT + index) * 4;
+}
+
+void FlatShader::vertex(const float* attributes, const float* uniforms, SoftwareVertex& out) const {
+    out.position[0] = attributes[0];
+    out.position[1] = attributes[1];
+    out.position[2] = 0;
+    out.position[3] = 1;
+}
+
+void FlatShader::fragment(const float* varyings, const float* uniforms, float color[4]) const {
+    memcpy(color, drawConstant(uniforms, 0), 4 * sizeof(float));
+}
+
+void ColoredShader::vertex(const float* attributes, const float* uniforms, SoftwareVertex& out) const {
+    //position (xy), then color (rgba)
+    out.position[0] = attributes[0];
+    out.position[1] = attributes[1];
+    out.position[2] = 0;
+    out.position[3] = 1;
+    for (int i = 0; i < 4; i++)
+        out.varyings[i] = attributes[2 + i];
+}
+
+void ColoredShader::fragment(const float* varyings, const float* uniforms, float color[4]) const {
+    const float* tint = frameConstant(uniforms, 0);
+    for (int i = 0; i < 4; i++)
+        color[i] = varyings[i] * tint[i];
+}
+
+void RingShader::vertex(const float* attributes, const float* uniforms, SoftwareVertex& out) const {
+    float time = frameConstant(uniforms, 1)[0];
+    const float* offset = drawConstant(uniforms, 0);
+    float s = sin(time * 0.5f);
+    float c = cos(time * 0.5f);
+    out.position[0] = attributes[0] * 0.1f + (offset[0] * c - offset[1] * s);
+    out.position[1] = attributes[1] * 0.1f + (offset[0] * s + offset[1] * c);
+    out.position[2] = 0;
+    out.position[3] = 1;
+}
+
+void RingShader::fragment(const float* varyings, const float* uniforms, float color[4]) const {
+    memcpy(color, drawConstant(uniforms, 1), 4 * sizeof(float));
+}
+
+BackendDemoScene::BackendDemoScene(RenderBackend& backend)
+    : backend(backend),
+    flatShader(),
+    coloredShader(),
+    ringShader(),
+    r(0),
+    increment(0.05f),
+    gridData(DemoScene::GRID_SIZE * DemoScene::GRID_SIZE * 4) {
+
+    VertexBufferLayout quadLayout;
+    quadLayout.push<float>(2);
+    VertexBufferLayout gridLayout;
+    gridLayout.push<float>(2); //position
+    gridLayout.push<float>(4); //color
+
+    PipelineDesc flatDesc = { "res/shaders/BackendFlat.glsl", &flatShader, quadLayout };
+    PipelineDesc coloredDesc = { "res/shaders/BackendColored.glsl", &coloredShader, gridLayout };
+    PipelineDesc ringDesc = { "res/shaders/BackendRing.glsl", &ringShader, quadLayout };
+    flatPipeline = backend.createPipeline(flatDesc);
+    coloredPipeline = backend.createPipeline(coloredDesc);
+    ringPipeline = backend.createPipeline(ringDesc);
+
+    quadVertices = backend.createBuffer(BufferType::VERTEX, QUAD_POSITIONS, sizeof(QUAD_POSITIONS));
+    quadIndices = backend.createBuffer(BufferType::INDEX, QUAD_INDICES, sizeof(QUAD_INDICES));
+
+    //Same pattern as the BatchRenderer's
+    unsigned int quadCount = DemoScene::GRID_SIZE * DemoScene::GRID_SIZE;
+    vector<unsigned int> indices;
+    indices.reserve(quadCount * 6);
+    for (unsigned int i = 0; i < quadCount; i++) {
+        unsigned int first = i * 4;
+        indices.push_back(first + 0);
+        indices.push_back(first + 1);
+        indices.push_back(first + 2);
+        indices.push_back(first + 2);
+        indices.push_back(first + 3);
+        indices.push_back(first + 0);
+    }
+    gridVertices = backend.createBuffer(BufferType::VERTEX, nullptr, (unsigned int) (gridData.size() * sizeof(GridVertex)));
+    gridIndices = backend.createBuffer(BufferType::INDEX, indices.data(), (unsigned int) (indices.size() * sizeof(unsigned int)));
+
+    vector<DrawCommand> draws;
+    DrawCommand grid = { coloredPipeline, gridVertices, gridIndices, (unsigned int) indices.size(), 0, {} };
+    draws.push_back(grid);
+
+    //Same as generateRingInstances in DemoScene.cpp
+    for (int i = 0; i < DemoScene::INSTANCE_COUNT; i++) {
+        float angle = 6.2831853f * i / DemoScene::INSTANCE_COUNT;
+        DrawCommand instance = { ringPipeline, quadVertices, quadIndices, 6, 0, {} };
+        instance.constants[0][0] = 0.8f * cos(angle);
+        instance.constants[0][1] = 0.8f * sin(angle);
+        instance.constants[1][0] = (float) i / DemoScene::INSTANCE_COUNT;
+        instance.constants[1][1] = 1 - (float) i / DemoScene::INSTANCE_COUNT;
+        instance.constants[1][2] = 0.5f;
+        instance.constants[1][3] = 1;
+        draws.push_back(instance);
+    }
+    staticCommands = backend.recordCommands(draws);
+}
+
+BackendDemoScene::~BackendDemoScene() {
+    backend.destroyCommands(staticCommands);
+    backend.destroyBuffer(gridIndices);
+    backend.destroyBuffer(gridVertices);
+    backend.destroyBuffer(quadIndices);
+    backend.destroyBuffer(quadVertices);
+    backend.destroyPipeline(ringPipeline);
+    backend.destroyPipeline(coloredPipeline);
+    backend.destroyPipeline(flatPipeline);
+}
+
+void BackendDemoScene::render(float time) {
+    backend.beginFrame(0, 0, 0, 0);
+
+    float pulse = 0.75f + 0.25f * sin(time);
+    const float frameConstants[BACKEND_CONSTANT_COUNT][4] = {
+        { pulse, pulse, pulse, 1 },
+        { time, 0, 0, 0 }
+    };
+    backend.setFrameConstants(frameConstants);
+
+    updateGrid();
+    backend.submit(staticCommands);
+
+    DrawCommand center = { flatPipeline, quadVertices, quadIndices, 6, 0, { { r, 0.6f, 0.8f, 1 } } };
+    backend.draw(center);
+
+    backend.endFrame();
+
+    if (r > 1)
+        increment = -0.05f;
+    else if (r < 0)
+        increment = 0.05f;
+    r += increment;
+}
+
+void BackendDemoScene::updateGrid() {
+    const int GRID_SIZE = DemoScene::GRID_SIZE;
+    const float CELL_SIZE = 2.0f / GRID_SIZE;
+    GridVertex* vertex = gridData.data();
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            const float color[4] = { r * x / GRID_SIZE, 0.2f, (float) y / GRID_SIZE, 1 };
+            float left = -1 + x * CELL_SIZE;
+            float bottom = -1 + y * CELL_SIZE;
+            float size = CELL_SIZE * 0.9f;
+            const float xs[4] = { left, left + size, left + size, left };
+            const float ys[4] = { bottom, bottom, bottom + size, bottom + size };
+            for (int i = 0; i < 4; i++, vertex++) {
+                vertex->position[0] = xs[i];
+                vertex->position[1] = ys[i];
+                memcpy(vertex->color, color, sizeof(color));
+            }
+        }
+    }
+    backend.updateBuffer(gridVertices, gridData.data(), (unsigned int) (gridData.size() * sizeof(GridVertex)));
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+
+#include "RenderBackend.h"
+#include "SoftwareRasterizer.h"
+
+using std::vector;
+
+//res/shaders/BackendFlat.glsl, in C++
+class FlatShader : public SoftwareShader {
+    public:
+    unsigned int getVaryingCount() const override { return 0; }
+    void vertex(const float* attributes, const float* uniforms, SoftwareVertex& out) const override;
+    void fragment(const float* varyings, const float* uniforms, float color[4]) const override;
+};
+
+//res/shaders/BackendColored.glsl, in C++
+class ColoredShader : public SoftwareShader {
+    public:
+    unsigned int getVaryingCount() const override { return 4; }
+    void vertex(const float* attributes, const float* uniforms, SoftwareVertex& out) const override;
+    void fragment(const float* varyings, const float* uniforms, float color[4]) const override;
+};
+
+//res/shaders/BackendRing.glsl, in C++
+class RingShader : public SoftwareShader {
+    public:
+    unsigned int getVaryingCount() const override { return 0; }
+    void vertex(const float* attributes, const float* uniforms, SoftwareVertex& out) const override;
+    void fragment(const float* varyings, const float* uniforms, float color[4]) const override;
+};
+
+/// <summary>
+/// The same frames as <see cref="DemoScene"/>, drawn through a <see cref="RenderBackend"/>, so any backend can render them.
+/// </summary>
+//NOTE: The grid and the ring never change (only the frame constants and the grid's vertices do), so they're recorded into a command list once.
+class BackendDemoScene {
+    private:
+    struct GridVertex {
+        float position[2];
+        float color[4];
+    };
+
+    RenderBackend& backend;
+
+    //NOTE: Declared before the pipelines, since the software backend's pipelines point at them.
+    FlatShader flatShader;
+    ColoredShader coloredShader;
+    RingShader ringShader;
+
+    PipelineHandle flatPipeline;
+    PipelineHandle coloredPipeline;
+    PipelineHandle ringPipeline;
+
+    BufferHandle quadVertices;
+    BufferHandle quadIndices;
+    float r;
+    float increment;
+
+    vector<GridVertex> gridData;
+    BufferHandle gridVertices;
+    BufferHandle gridIndices;
+
+    CommandListHandle staticCommands;
+
+    public:
+    BackendDemoScene(RenderBackend& backend);
+    ~BackendDemoScene();
+
+    BackendDemoScene(const BackendDemoScene& other) = delete;
+    BackendDemoScene& operator=(const BackendDemoScene& other) = delete;
+
+    /// <param name="time">In seconds, since the start of the demo.</param>
+    void render(float time);
+
+    private:
+    void updateGrid();
+};
@@ -0,0 +1,127 @@
+#include "OpenGLUtil.h"
+#include "BatchRenderer.h"
+#include "GpuProfiler.h"
+#include "RenderStats.h"
+
+BatchRenderer::BatchRenderer(unsigned int maxQuads, const string& shaderPath)
+    : maxQuads(maxQuads),
+    batchVertices(nullptr),
+    batchQuadCount(0),
+    batchOffset(0),
+    batchMapped(false),
+    batchTextured(false),
+    va(),
+    vb(GL_ARRAY_BUFFER, maxQuads * 4 * sizeof(QuadVertex) * BATCHES_PER_REGION),
+    ib(generateQuadIndices(maxQuads).data(), maxQuads * 6),
+    shaders(shaderPath),
+    texturedKey(shaders.makeKey({ "TEXTURED" })),
+    stats() {
+
+    VertexBufferLayout layout;
+    layout.push<float>(2); //position
+    layout.push<float>(4); //color
+    layout.push<float>(2); //texCoord
+    layout.push<float>(1); //texIndex
+    va.addBuffer(vb, layout);
+
+    //NOTE: The index buffer was created before our VAO was bound, so attach it now.
+    ib.bind();
+}
+
+void BatchRenderer::begin() {
+    stats = BatchStats();
+    mapBatch();
+}
+
+void BatchRenderer::drawQuad(float x, float y, float width, float height, const float color[4]) {
+    const float uvRect[4] = { 0, 0, 1, 1 };
+    drawQuad(x, y, width, height, color, -1, uvRect);
+}
+
+void BatchRenderer::drawQuad(float x, float y, float width, float height, const float color[4], int textureSlot, const float uvRect[4]) {
+    ASSERT(textureSlot < MAX_TEXTURE_SLOTS);
+    ASSERT(batchMapped);
+    if (batchQuadCount >= maxQuads) {
+        flush();
+        mapBatch();
+    }
+
+    const float xs[4] = { x, x + width, x + width, x };
+    const float ys[4] = { y, y, y + height, y + height };
+    const float us[4] = { uvRect[0], uvRect[2], uvRect[2], uvRect[0] };
+    const float vs[4] = { uvRect[1], uvRect[1], uvRect[3], uvRect[3] };
+
+    QuadVertex* vertex = &batchVertices[batchQuadCount * 4];
+    for (int i = 0; i < 4; i++, vertex++) {
+        vertex->position[0] = xs[i];
+        vertex->position[1] = ys[i];
+        vertex->color[0] = color[0];
+        vertex->color[1] = color[1];
+        vertex->color[2] = color[2];
+        vertex->color[3] = color[3];
+        vertex->texCoord[0] = us[i];
+        vertex->texCoord[1] = vs[i];
+        vertex->texIndex = (float) textureSlot;
+    }
+    batchTextured |= textureSlot >= 0;
+    batchQuadCount++;
+    stats.quadCount++;
+}
+
+void BatchRenderer::end() {
+    flush();
+    vb.endFrame();
+}
+
+void BatchRenderer::mapBatch() {
+    //NOTE: Aligned to the vertex size, so the offset divides evenly into a base vertex.
+    batchVertices = (QuadVertex*) vb.map(maxQuads * 4 * sizeof(QuadVertex), sizeof(QuadVertex), batchOffset);
+    batchQuadCount = 0;
+    batchMapped = true;
+    batchTextured = false;
+}
+
+void BatchRenderer::flush() {
+    if (!batchMapped)
+        return;
+    vb.unmap(batchQuadCount * 4 * sizeof(QuadVertex));
+    batchMapped = false;
+
+    if (batchQuadCount == 0)
+        return;
+
+    GpuProfiler::Scope scope("BatchRenderer::flush");
+
+    //NOTE: The textured variant is only compiled once we first draw a textured quad, so that's when its samplers get pointed at their slots.
+    ShaderVariants::Key key = batchTextured ? texturedKey : 0;
+    bool firstUse = !shaders.isCompiled(key);
+    Shader& shader = shaders.get(key);
+    shader.bind();
+    if (firstUse && batchTextured) {
+        int slots[MAX_TEXTURE_SLOTS];
+        for (int i = 0; i < MAX_TEXTURE_SLOTS; i++)
+            slots[i] = i;
+        shader.set("u_Textures"_u, slots, MAX_TEXTURE_SLOTS);
+    }
+    va.bind();
+    ib.bind();
+    GLCALL(glDrawElementsBaseVertex(GL_TRIANGLES, batchQuadCount * 6, GL_UNSIGNED_INT, NULL, batchOffset / sizeof(QuadVertex)));
+
+    stats.drawCalls++;
+    RenderStats::get().onDraw(batchQuadCount * 2);
+}
+
+vector<unsigned int> BatchRenderer::generateQuadIndices(unsigned int quadCount) {
+    vector<unsigned int> indices;
+    indices.reserve(quadCount * 6);
+    for (unsigned int i = 0; i < quadCount; i++) {
+        unsigned int first = i * 4;
+        indices.push_back(first + 0);
+        indices.push_back(first + 1);
+        indices.push_back(first + 2);
+        indices.push_back(first + 2);
+        indices.push_back(first + 3);
+        indices.push_back(first + 0);
+    }
+    return indices;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "IndexBuffer.h"
+#include "ShaderVariants.h"
+#include "StreamBuffer.h"
+#include "VertexArray.h"
+
+using std::string;
+using std::vector;
+
+struct QuadVertex {
+    float position[2];
+    float color[4];
+    float texCoord[2];
+    float texIndex; //NOTE: Texture slot to sample from, or -1 for a plain colored quad.
+};
+
+struct BatchStats {
+    unsigned int drawCalls;
+    unsigned int quadCount;
+};
+
+/// <summary>
+/// Collects 2D quads into one big dynamic vertex buffer and draws them with as few draw calls as possible,
+/// instead of one glDrawElements per quad.
+/// </summary>
+//NOTE: All quads share one index buffer that we generate up front, since every quad uses the same 6-index pattern.
+//      Quads are written straight into a StreamBuffer's mapped memory, and each batch is drawn from wherever it landed with a base vertex.
+class BatchRenderer {
+    public:
+    //NOTE: Must match the size of the u_Textures array in res/shaders/Batch.glsl.
+    static const int MAX_TEXTURE_SLOTS = 8;
+
+    //How many full batches fit in each frame's region of the stream buffer before it has to move on early.
+    static const int BATCHES_PER_REGION = 4;
+
+    private:
+    unsigned int maxQuads;
+
+    //The batch we're currently writing, in the stream buffer's mapped memory
+    QuadVertex* batchVertices;
+    unsigned int batchQuadCount;
+    unsigned int batchOffset;
+    bool batchMapped;
+    bool batchTextured; //Whether any quad in the batch samples a texture, so it needs the TEXTURED variant of the shader
+
+    VertexArray va;
+    StreamBuffer vb;
+    IndexBuffer ib;
+    ShaderVariants shaders;
+    ShaderVariants::Key texturedKey;
+
+    BatchStats stats;
+
+    public:
+    BatchRenderer(unsigned int maxQuads = 10000, const string& shaderPath = "res/shaders/Batch.glsl");
+
+    /// <summary>
+    /// Starts a new frame's worth of quads, and resets the stats.
+    /// </summary>
+    void begin();
+
+    void drawQuad(float x, float y, float width, float height, const float color[4]);
+
+    /// <param name="textureSlot">The texture unit to sample from, in [0, MAX_TEXTURE_SLOTS). The caller binds the texture there.</param>
+    /// <param name="uvRect">The texture coordinates for the bottom-left (u0, v0) and top-right (u1, v1) corners.</param>
+    void drawQuad(float x, float y, float width, float height, const float color[4], int textureSlot, const float uvRect[4]);
+
+    /// <summary>
+    /// Draws whatever's left in the batch. Call once per frame, since this also ends the frame for the stream buffer.
+    /// </summary>
+    void end();
+
+    inline ShaderVariants& getShaders() { return shaders; }
+    inline const BatchStats& getStats() const { return stats; }
+
+    private:
+    void mapBatch();
+    void flush();
+    static vector<unsigned int> generateQuadIndices(unsigned int quadCount);
+};
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#include "Benchmark.h"
+#include "GpuProfiler.h"
+
+using std::cout;
+using std::endl;
+
+Benchmark::Benchmark(unsigned int warmupFrames, unsigned int measuredFrames)
+    : warmupFrames(warmupFrames),
+    measuredFrames(measuredFrames),
+    frame(0),
+    frameWaitTime(0) {
+    frameTimes.reserve(measuredFrames);
+    cpuTimes.reserve(measuredFrames);
+    waitTimes.reserve(measuredFrames);
+    gpuTimes.resize(measuredFrames, std::numeric_limits<double>::quiet_NaN());
+
+    GpuProfiler::get().setEnabled(true);
+    GpuProfiler::get().reset();
+}
+
+Benchmark::~Benchmark() {
+    GpuProfiler::get().setEnabled(false);
+    GpuProfiler::get().release();
+}
+
+void Benchmark::beginFrame() {
+    frameStart = Clock::now();
+    gpuTimer.begin(frame);
+}
+
+void Benchmark::endSubmit() {
+    gpuTimer.end();
+    submitEnd = Clock::now();
+}
+
+void Benchmark::endFrame() {
+    Clock::time_point frameEnd = Clock::now();
+    if (!isWarmingUp() && !isDone()) {
+        frameTimes.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+        cpuTimes.push_back(std::chrono::duration<double, std::milli>(submitEnd - frameStart).count());
+        waitTimes.push_back(frameWaitTime);
+    }
+    frame++;
+    frameWaitTime = 0;
+
+    gpuTimer.collect(gpuResults);
+    storeGpuResults();
+
+    GpuProfiler& profiler = GpuProfiler::get();
+    profiler.endFrame();
+    if (frame == warmupFrames)
+        profiler.reset();
+}
+
+void Benchmark::finish() {
+    gpuTimer.drain(gpuResults);
+    storeGpuResults();
+
+    //NOTE: Regions from frames after the last measured one (if any) would get counted too, but finish() comes right after it.
+    GpuProfiler::get().drain();
+}
+
+TimingSummary Benchmark::summarize(const vector<double>& samples) {
+    vector<double> sorted;
+    sorted.reserve(samples.size());
+    for (double sample : samples) {
+        if (!std::isnan(sample))
+            sorted.push_back(sample);
+    }
+
+    TimingSummary summary = { };
+    summary.sampleCount = (unsigned int) sorted.size();
+    if (sorted.empty())
+        return summary;
+
+    std::sort(sorted.begin(), sorted.end());
+
+    double total = 0;
+    for (double sample : sorted)
+        total += sample;
+
+    //Nearest-rank percentiles
+    size_t n = sorted.size();
+    summary.min = sorted.front();
+    summary.mean = total / n;
+    summary.p50 = sorted[(size_t) std::ceil(0.50 * n) - 1];
+    summary.p95 = sorted[(size_t) std::ceil(0.95 * n) - 1];
+    summary.p99 = sorted[(size_t) std::ceil(0.99 * n) - 1];
+    summary.max = sorted.back();
+    return summary;
+}
+
+static void printSummary(const char* name, const TimingSummary& summary) {
+    cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(3)
+        << " min " << std::setw(8) << summary.min
+        << "  mean " << std::setw(8) << summary.mean
+        << "  p50 " << std::setw(8) << summary.p50
+        << "  p95 " << std::setw(8) << summary.p95
+        << "  p99 " << std::setw(8) << summary.p99
+        << "  max " << std::setw(8) << summary.max
+        << "  (" << summary.sampleCount << " samples)" << endl;
+}
+
+void Benchmark::printReport() const {
+    cout << "Benchmark: " << measuredFrames << " frames (after " << warmupFrames << " warm-up frames), in milliseconds:" << endl;
+    printSummary("Frame", summarize(frameTimes));
+    printSummary("CPU", summarize(cpuTimes));
+    printSummary("GPU", summarize(gpuTimes));
+    printSummary("Wait", summarize(waitTimes));
+
+    vector<GpuRegionStats> regions = GpuProfiler::get().getRegionStats();
+    if (regions.empty())
+        return;
+    cout << "GPU regions, in milliseconds:" << endl;
+    for (const GpuRegionStats& region : regions) {
+        cout << "  " << std::left << std::setw(28) << region.name << std::right << std::fixed << std::setprecision(3)
+            << " per frame " << std::setw(8) << region.getMsPerFrame()
+            << "  per call " << std::setw(8) << region.getMsPerCall()
+            << "  (" << region.callCount << " calls over " << region.frameCount << " frames)" << endl;
+    }
+}
+
+bool Benchmark::writeCsv(const string& filePath) const {
+    std::ofstream stream = std::ofstream(filePath);
+    if (!stream) {
+        cout << "Failed to open " << filePath << " for writing!" << endl;
+        return false;
+    }
+
+    stream << "frame,frame_ms,cpu_ms,gpu_ms,wait_ms\n";
+    for (size_t i = 0; i < frameTimes.size(); i++) {
+        stream << i << "," << frameTimes[i] << "," << cpuTimes[i] << ",";
+        if (!std::isnan(gpuTimes[i]))
+            stream << gpuTimes[i];
+        stream << "," << waitTimes[i] << "\n";
+    }
+    return (bool) stream;
+}
+
+static void writeJsonSummary(std::ofstream& stream, const char* name, const TimingSummary& summary, bool last) {
+    stream << "    \"" << name << "\": { "
+        << "\"samples\": " << summary.sampleCount
+        << ", \"min\": " << summary.min
+        << ", \"mean\": " << summary.mean
+        << ", \"p50\": " << summary.p50
+        << ", \"p95\": " << summary.p95
+        << ", \"p99\": " << summary.p99
+        << ", \"max\": " << summary.max
+        << " }" << (last ? "\n" : ",\n");
+}
+
+bool Benchmark::writeJson(const string& filePath) const {
+    std::ofstream stream = std::ofstream(filePath);
+    if (!stream) {
+        cout << "Failed to open " << filePath << " for writing!" << endl;
+        return false;
+    }
+
+    stream << "{\n";
+    stream << "  \"warmupFrames\": " << warmupFrames << ",\n";
+    stream << "  \"measuredFrames\": " << measuredFrames << ",\n";
+    stream << "  \"milliseconds\": {\n";
+    writeJsonSummary(stream, "frame", summarize(frameTimes), false);
+    writeJsonSummary(stream, "cpu", summarize(cpuTimes), false);
+    writeJsonSummary(stream, "gpu", summarize(gpuTimes), false);
+    writeJsonSummary(stream, "wait", summarize(waitTimes), true);
+    stream << "  },\n";
+
+    vector<GpuRegionStats> regions = GpuProfiler::get().getRegionStats();
+    stream << "  \"gpuRegions\": [";
+    for (size_t i = 0; i < regions.size(); i++) {
+        const GpuRegionStats& region = regions[i];
+        stream << (i == 0 ? "\n" : ",\n")
+            << "    { \"name\": \"" << region.name << "\""
+            << ", \"calls\": " << region.callCount
+            << ", \"frames\": " << region.frameCount
+            << ", \"msPerFrame\": " << region.getMsPerFrame()
+            << ", \"msPerCall\": " << region.getMsPerCall()
+            << " }";
+    }
+    stream << (regions.empty() ? "]\n" : "\n  ]\n");
+    stream << "}\n";
+    return (bool) stream;
+}
+
+void Benchmark::storeGpuResults() {
+    for (const std::pair<uint64_t, double>& result : gpuResults) {
+        if (result.first < warmupFrames || result.first >= (uint64_t) warmupFrames + measuredFrames)
+            continue;
+        gpuTimes[(size_t) (result.first - warmupFrames)] = result.second;
+    }
+    gpuResults.clear();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "GpuTimer.h"
+
+using std::string;
+using std::vector;
+
+struct TimingSummary {
+    unsigned int sampleCount;
+    double min;
+    double mean;
+    double p50;
+    double p95;
+    double p99;
+    double max;
+};
+
+/// <summary>
+/// Times a fixed number of frames (after some warm-up frames we throw away), so runs can be compared across commits.
+/// For each frame we record the whole frame time, the CPU time spent submitting it, and the GPU time it took.
+/// When frames in flight are limited (see FrameLimiter), we also record how long the CPU waited on the GPU each frame.
+/// </summary>
+//NOTE: Usage, each frame:
+//      benchmark.beginFrame();
+//      ...render...
+//      benchmark.endSubmit();
+//      ...swap buffers...
+//      benchmark.addWaitTime(limiter.getLastWaitTime());  //If there's a FrameLimiter
+//      benchmark.endFrame();
+//Run with vsync off, or you'll just be measuring your display's refresh rate.
+class Benchmark {
+    private:
+    typedef std::chrono::steady_clock Clock;
+
+    unsigned int warmupFrames;
+    unsigned int measuredFrames;
+    unsigned int frame; //Counting warm-up frames too
+
+    Clock::time_point frameStart;
+    Clock::time_point submitEnd;
+
+    vector<double> frameTimes;  //All in milliseconds, one per measured frame
+    vector<double> cpuTimes;
+    vector<double> gpuTimes;    //NOTE: NaN for frames whose GPU time never came back (see GpuTimer).
+    vector<double> waitTimes;
+    double frameWaitTime;       //Added up over the current frame
+
+    GpuTimer gpuTimer;
+    vector<std::pair<uint64_t, double>> gpuResults;
+
+    public:
+    Benchmark(unsigned int warmupFrames, unsigned int measuredFrames);
+    ~Benchmark();
+
+    void beginFrame();
+    void endSubmit();
+
+    //Adds to how long the CPU spent waiting on the GPU (not submitting anything) this frame, in milliseconds
+    inline void addWaitTime(double milliseconds) { frameWaitTime += milliseconds; }
+
+    void endFrame();
+
+    inline bool isDone() const { return frame >= warmupFrames + measuredFrames; }
+    inline bool isWarmingUp() const { return frame < warmupFrames; }
+
+    /// <summary>
+    /// Waits for the last GPU times to come back. Call once after the last frame, before reporting.
+    /// </summary>
+    void finish();
+
+    static TimingSummary summarize(const vector<double>& samples);
+
+    //NOTE: The reports include the GpuProfiler's regions, which the benchmark enables for as long as it lives.
+    void printReport() const;
+    bool writeCsv(const string& filePath) const;
+    bool writeJson(const string& filePath) const;
+
+    private:
+    void storeGpuResults();
+};
@@ -0,0 +1,50 @@
+#include "CommandBuffer.h"
+
+uint64_t CommandBuffer::makeSortKey(unsigned int pass, unsigned int shaderId, unsigned int material, unsigned int vaoId, float depth) {
+    //NOTE: NaN fails every comparison, so it has to be caught first or it would reach the float -> integer conversion below (undefined behaviour).
+    //      It sorts as the far plane.
+    if (depth != depth || depth > 1)
+        depth = 1;
+    else if (depth < 0)
+        depth = 0;
+
+    //NOTE: Ids wider than their field just wrap around. That only costs us some grouping, never correctness,
+    //      since Renderer::flush() compares the actual objects before deciding to skip a bind.
+    uint64_t key = 0;
+    key |= (uint64_t) (pass & 0xF) << 60;
+    key |= (uint64_t) (shaderId & 0xFFF) << 48;
+    key |= (uint64_t) (material & 0xFFF) << 36;
+    key |= (uint64_t) (vaoId & 0xFFF) << 24;
+    key |= (uint64_t) (depth * 0xFFFFFF);
+    return key;
+}
+
+DrawPacket CommandBuffer::makePacket(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, unsigned int baseInstance,
+    unsigned int pass, unsigned int material, float depth) {
+    DrawPacket packet = {
+        makeSortKey(pass, shader.getRendererId(), material, va.getRendererId(), depth),
+        &va,
+        &ib,
+        &shader,
+        instanceCount,
+        baseInstance
+    };
+    return packet;
+}
+
+void CommandBuffer::submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int pass, unsigned int material, float depth) {
+    packets.push_back(makePacket(va, ib, shader, 1, 0, pass, material, depth));
+}
+
+void CommandBuffer::submitInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, unsigned int baseInstance,
+    unsigned int pass, unsigned int material, float depth) {
+    packets.push_back(makePacket(va, ib, shader, instanceCount, baseInstance, pass, material, depth));
+}
+
+void CommandBuffer::clear() {
+    packets.clear();
+}
+
+void CommandBuffer::reserve(size_t count) {
+    packets.reserve(count);
+}
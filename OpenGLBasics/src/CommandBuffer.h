@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "VertexArray.h"
+
+using std::vector;
+
+/// <summary>
+/// A single recorded draw, waiting to be sorted and issued by <see cref="Renderer::flush"/>.
+/// </summary>
+struct DrawPacket {
+    uint64_t sortKey;
+    const VertexArray* va;
+    const IndexBuffer* ib;
+    const Shader* shader;
+    unsigned int instanceCount;
+    unsigned int baseInstance;
+};
+
+/// <summary>
+/// A list of draw packets that can be recorded on any thread, since recording never touches OpenGL.
+/// Give each worker thread its own CommandBuffer (see CommandRecorder), then hand them all to <see cref="Renderer::submit(const CommandBuffer&)"/> on the GL thread.
+/// </summary>
+//NOTE: The packets only point at the resources, so they all need to outlive the Renderer::flush() that draws them.
+//      CommandBuffers aren't thread-safe themselves: one thread records into one CommandBuffer at a time.
+class CommandBuffer {
+    private:
+    vector<DrawPacket> packets;
+
+    public:
+    /// <summary>
+    /// Packs a draw's state into a 64-bit key, most significant first:
+    /// pass (4 bits) | shader (12 bits) | material (12 bits) | VAO (12 bits) | depth (24 bits).
+    /// Sorting by this key groups draws by pass, then program, then material, then VAO, so each switch happens once per group.
+    /// </summary>
+    /// <param name="depth">Normalized to [0, 1], sorted front-to-back. Pass (1 - depth) for back-to-front (transparent) passes.</param>
+    static uint64_t makeSortKey(unsigned int pass, unsigned int shaderId, unsigned int material, unsigned int vaoId, float depth);
+
+    static DrawPacket makePacket(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, unsigned int baseInstance,
+        unsigned int pass, unsigned int material, float depth);
+
+    void submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int pass = 0, unsigned int material = 0, float depth = 0);
+    void submitInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, unsigned int baseInstance = 0,
+        unsigned int pass = 0, unsigned int material = 0, float depth = 0);
+
+    //NOTE: Keeps the memory around, so recording the next frame doesn't need to allocate.
+    void clear();
+    void reserve(size_t count);
+
+    inline size_t getCount() const { return packets.size(); }
+    inline const vector<DrawPacket>& getPackets() const { return packets; }
+};
@@ -0,0 +1,74 @@
+#include <algorithm>
+
+#include "CommandRecorder.h"
+#include "CpuProfiler.h"
+
+CommandRecorder::CommandRecorder(unsigned int threadCount)
+    : threadCount(threadCount != 0 ? threadCount : std::max(std::thread::hardware_concurrency(), 1u)),
+    commandBuffers(this->threadCount),
+    recordCount(0),
+    busyWorkers(0),
+    stopping(false),
+    recordFunction(nullptr),
+    itemCount(0) {
+    workers.reserve(this->threadCount - 1);
+    for (unsigned int i = 1; i < this->threadCount; i++)
+        workers.emplace_back(&CommandRecorder::workerLoop, this, i);
+}
+
+CommandRecorder::~CommandRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        stopping = true;
+    }
+    workStarted.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+void CommandRecorder::record(unsigned int itemCount, const RecordFunction& function) {
+    PROFILE_SCOPE("CommandRecorder::record");
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        recordFunction = &function;
+        this->itemCount = itemCount;
+        recordCount++;
+        busyWorkers = (unsigned int) workers.size();
+    }
+    workStarted.notify_all();
+    recordShare(0);
+    {
+        std::unique_lock<std::mutex> lock(workMutex);
+        workFinished.wait(lock, [this]() { return busyWorkers == 0; });
+        recordFunction = nullptr;
+    }
+}
+
+void CommandRecorder::workerLoop(unsigned int thread) {
+    uint64_t lastRecord = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(workMutex);
+            workStarted.wait(lock, [this, lastRecord]() { return stopping || recordCount != lastRecord; });
+            if (stopping)
+                return;
+            lastRecord = recordCount;
+        }
+
+        recordShare(thread);
+
+        std::lock_guard<std::mutex> lock(workMutex);
+        if (--busyWorkers == 0)
+            workFinished.notify_one();
+    }
+}
+
+void CommandRecorder::recordShare(unsigned int thread) {
+    PROFILE_SCOPE("CommandRecorder share");
+    CommandBuffer& commands = commandBuffers[thread];
+    commands.clear();
+    unsigned int begin = (unsigned int) ((uint64_t) itemCount * thread / threadCount);
+    unsigned int end = (unsigned int) ((uint64_t) itemCount * (thread + 1) / threadCount);
+    if (begin < end)
+        (*recordFunction)(begin, end, commands);
+}
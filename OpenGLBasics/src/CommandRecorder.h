@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CommandBuffer.h"
+
+using std::vector;
+
+/// <summary>
+/// Records draw packets on several threads at once: record() splits a range of items (objects in a scene, say) evenly across its threads,
+/// and each thread records its share into a CommandBuffer of its own. Hand getCommandBuffers() to <see cref="Renderer::submit(const vector<CommandBuffer>&)"/>
+/// afterwards, on the GL thread.
+/// </summary>
+//NOTE: The threads live as long as the recorder, and sleep between record() calls. record()'s own thread records the first share.
+//      Each thread always gets the same share, and the buffers are merged in order, so what ends up drawn doesn't depend on the thread count.
+class CommandRecorder {
+    public:
+    //Records items [begin, end) into commands. Runs on worker threads, so it must not touch OpenGL.
+    typedef std::function<void(unsigned int begin, unsigned int end, CommandBuffer& commands)> RecordFunction;
+
+    private:
+    unsigned int threadCount;
+    vector<CommandBuffer> commandBuffers; //One per thread
+
+    vector<std::thread> workers;
+    std::mutex workMutex;
+    std::condition_variable workStarted;   //Workers wait on this for the next record() (or for stopping)
+    std::condition_variable workFinished;  //record() waits on this for the workers to finish their shares
+    uint64_t recordCount;                   //Bumped for each record(), so workers know there's new work
+    unsigned int busyWorkers;
+    bool stopping;
+
+    //What the current record() is recording
+    const RecordFunction* recordFunction;
+    unsigned int itemCount;
+
+    public:
+    /// <param name="threadCount">How many threads record, or 0 for one per core.</param>
+    CommandRecorder(unsigned int threadCount = 0);
+    ~CommandRecorder();
+
+    //NOTE: Owns its worker threads, so no copies.
+    CommandRecorder(const CommandRecorder&) = delete;
+    CommandRecorder& operator=(const CommandRecorder&) = delete;
+
+    inline unsigned int getThreadCount() const { return threadCount; }
+
+    /// <summary>
+    /// Clears every thread's CommandBuffer, then records items [0, itemCount) with function, returning once they're all recorded.
+    /// </summary>
+    void record(unsigned int itemCount, const RecordFunction& function);
+
+    inline const vector<CommandBuffer>& getCommandBuffers() const { return commandBuffers; }
+
+    private:
+    void workerLoop(unsigned int thread);
+    void recordShare(unsigned int thread);
+};
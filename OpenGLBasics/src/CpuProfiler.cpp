@@ -0,0 +1,111 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "CpuProfiler.h"
+
+using std::cout;
+using std::endl;
+
+std::mutex CpuProfiler::buffersMutex;
+vector<std::unique_ptr<CpuProfiler::ThreadBuffer>> CpuProfiler::buffers;
+std::atomic<bool> CpuProfiler::enabled(false);
+
+//NOTE: A scope decides whether it's recorded when it starts, so turning recording on or off mid-scope can't unbalance the depths.
+CpuProfiler::Scope::Scope(const char* name)
+    : name(isEnabled() ? name : nullptr),
+    start(0) {
+    if (this->name == nullptr)
+        return;
+    getThreadBuffer().depth++;
+    start = now();
+}
+
+CpuProfiler::Scope::~Scope() {
+    if (name == nullptr)
+        return;
+    uint64_t end = now();
+    ThreadBuffer& buffer = getThreadBuffer();
+    buffer.depth--;
+
+    uint64_t count = buffer.count.load(std::memory_order_relaxed);
+    Event& event = buffer.events[count % EVENTS_PER_THREAD];
+    event.name = name;
+    event.start = start;
+    event.duration = end - start;
+    event.depth = buffer.depth;
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+CpuProfiler::ThreadBuffer::ThreadBuffer(unsigned int threadId)
+    : threadId(threadId),
+    depth(0),
+    events(EVENTS_PER_THREAD),
+    count(0) { }
+
+void CpuProfiler::setEnabled(bool enabled) {
+    CpuProfiler::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+//Chrome wants the names as JSON strings, and ours are usually plain identifiers, but just in case:
+static void writeJsonString(std::ofstream& stream, const char* text) {
+    stream << '"';
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\')
+            stream << '\\';
+        stream << *c;
+    }
+    stream << '"';
+}
+
+bool CpuProfiler::writeChromeTrace(const string& filePath) {
+    std::ofstream stream = std::ofstream(filePath);
+    if (!stream) {
+        cout << "Failed to open " << filePath << " for writing!" << endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    //NOTE: "X" (complete) events, with times in microseconds.
+    //      Fixed, with nanosecond decimals, since the default 6 significant digits would round timestamps past a second to 10us or worse.
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+        uint64_t count = buffer->count.load(std::memory_order_acquire);
+        uint64_t oldest = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD : 0;
+        for (uint64_t i = oldest; i < count; i++) {
+            const Event& event = buffer->events[i % EVENTS_PER_THREAD];
+            stream << (first ? "\n" : ",\n") << "  {\"name\": ";
+            writeJsonString(stream, event.name);
+            stream << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->threadId
+                << ", \"ts\": " << event.start / 1000.0
+                << ", \"dur\": " << event.duration / 1000.0
+                << ", \"args\": {\"depth\": " << event.depth << "}}";
+            first = false;
+        }
+
+        if (oldest > 0)
+            cout << "CPU profiler: thread " << buffer->threadId << " recorded " << count << " events, but only kept the last " << EVENTS_PER_THREAD << "." << endl;
+    }
+    stream << "\n]}\n";
+    return (bool) stream;
+}
+
+uint64_t CpuProfiler::now() {
+    static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+CpuProfiler::ThreadBuffer& CpuProfiler::getThreadBuffer() {
+    //NOTE: The buffers are owned by the profiler, not the thread, so their events survive the thread exiting.
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer((unsigned int) buffers.size() + 1)));
+        buffer = buffers.back().get();
+    }
+    return *buffer;
+}
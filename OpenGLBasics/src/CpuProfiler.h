@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+//NOTE: Define NO_INSTRUMENTATION (the ReleaseNoInstr configuration does) and every PROFILE_SCOPE compiles down to nothing.
+#ifdef NO_INSTRUMENTATION
+#define PROFILE_SCOPE(name)
+#else
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+//Times the rest of the enclosing block. The name must be a string literal (we only keep the pointer).
+#define PROFILE_SCOPE(name) CpuProfiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
+
+/// <summary>
+/// Records how long each PROFILE_SCOPE took on the CPU, on any thread, and writes them out as a Chrome trace
+/// (open it in about://tracing or https://ui.perfetto.dev) so you can see exactly what happened during a slow frame.
+/// </summary>
+//NOTE: Nothing's recorded until setEnabled(true) (the app does for --trace), so scopes cost next to nothing otherwise.
+//      Every thread records into its own fixed-size ring buffer, so recording never takes a lock, and a long run keeps its latest events.
+//      Only a thread's first scope takes one, to register its buffer. Nested scopes show up nested in the trace, since it's just going by the times.
+class CpuProfiler {
+    public:
+    class Scope {
+        private:
+        const char* name; //Null if we weren't recording when the scope started
+        uint64_t start;
+
+        public:
+        Scope(const char* name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    private:
+    //Per thread. Past this, each new event overwrites the oldest one, rather than ever allocating while recording.
+    static const unsigned int EVENTS_PER_THREAD = 1 << 16;
+
+    struct Event {
+        const char* name;
+        uint64_t start;     //Nanoseconds since the profiler started
+        uint64_t duration;
+        unsigned int depth;
+    };
+
+    struct ThreadBuffer {
+        unsigned int threadId;
+        unsigned int depth;
+        vector<Event> events;
+
+        //Events ever recorded. The latest EVENTS_PER_THREAD of them are in events, at count % EVENTS_PER_THREAD and before.
+        //NOTE: Only the owning thread writes events, and it publishes each one by bumping count afterwards,
+        //      so writeChromeTrace() can read up to count from any thread (though one still recording may overwrite what it's reading).
+        std::atomic<uint64_t> count;
+
+        ThreadBuffer(unsigned int threadId);
+    };
+
+    static std::mutex buffersMutex;
+    static vector<std::unique_ptr<ThreadBuffer>> buffers;
+    static std::atomic<bool> enabled;
+
+    public:
+    static void setEnabled(bool enabled);
+    static inline bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /// <summary>
+    /// Writes every event recorded so far, from every thread, as Chrome's JSON trace event format.
+    /// </summary>
+    static bool writeChromeTrace(const string& filePath);
+
+    private:
+    static uint64_t now();
+    static ThreadBuffer& getThreadBuffer();
+};
@@ -0,0 +1,153 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "OpenGLUtil.h"
+#include "DemoScene.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+static const float QUAD_POSITIONS[8] = {
+    0.5f,   -0.5f,
+    -0.5f,  -0.5f,
+    0.5f,   0.5f,
+    -0.5f,  0.5f
+};
+
+static const unsigned int QUAD_INDICES[6] = {
+    0, 1, 2,
+    3, 2, 1
+};
+
+//Per instance: offset (xy), then color (rgba)
+static vector<float> generateRingInstances(int count) {
+    vector<float> instances;
+    instances.reserve(count * 6);
+    for (int i = 0; i < count; i++) {
+        float angle = 6.2831853f * i / count;
+        instances.push_back(0.8f * cos(angle));
+        instances.push_back(0.8f * sin(angle));
+        instances.push_back((float) i / count);
+        instances.push_back(1 - (float) i / count);
+        instances.push_back(0.5f);
+        instances.push_back(1);
+    }
+    return instances;
+}
+
+DemoScene::DemoScene(ShaderCompileMode shaderMode)
+    : va(),
+    vb(QUAD_POSITIONS, sizeof(QUAD_POSITIONS)),
+    ib(QUAD_INDICES, 6),
+    shader("res/shaders/Basic.glsl", shaderMode),
+    colorUniform(),
+    r(0),
+    increment(0.05f),
+    instancedVa(),
+    instanceVb(generateRingInstances(INSTANCE_COUNT).data(), INSTANCE_COUNT * 6 * sizeof(float)),
+    instancedShader("res/shaders/Instanced.glsl", shaderMode),
+    ringCommands(),
+    fallbackShader("res/shaders/Fallback.glsl"),
+    frameLayout(),
+    tintOffset(frameLayout.push(4)),
+    timeOffset(frameLayout.push(1)),
+    frameUniforms("Frame", frameLayout.getSize()),
+    renderer(),
+    batchRenderer(),
+    statsStartTime(std::chrono::steady_clock::now()),
+    statsFrames(0),
+    statsQuads(0),
+    statsDrawCalls(0) {
+
+    VertexBufferLayout layout;
+    layout.push<float>(2);
+    va.addBuffer(vb, layout);
+
+    //NOTE: Binding a shader that's still compiling would wait for it, and it gets its color every frame anyway.
+    if (shader.isReady()) {
+        colorUniform = shader.getUniform<Vec4>("uniColor"_u);
+        shader.bind();
+        shader.setUniform(colorUniform, Vec4{ 0.2f, 0.6f, 0.8f, 1 });
+    }
+
+    //Unbind everything, just to demonstrate
+    va.unbind();
+    vb.unbind();
+    ib.unbind();
+    shader.unbind();
+
+    instancedVa.addBuffer(vb, layout);
+    VertexBufferLayout instanceLayout;
+    instanceLayout.push<float>(2, 1); //offset
+    instanceLayout.push<float>(4, 1); //color
+    instancedVa.addBuffer(instanceVb, instanceLayout);
+
+    //NOTE: The whole ring shares one VAO and shader, so it's one bucket, and it never changes, so it's uploaded just once.
+    ringCommands.push(6, 0, 0, INSTANCE_COUNT);
+    ringCommands.upload();
+
+    renderer.setFallbackShader(&fallbackShader);
+}
+
+bool DemoScene::isReady() const {
+    return shader.isReady() && instancedShader.isReady();
+}
+
+void DemoScene::render(float time) {
+    renderer.clear();
+
+    float pulse = 0.75f + 0.25f * sin(time);
+    frameUniforms.setVec4(tintOffset, pulse, pulse, pulse, 1);
+    frameUniforms.setFloat(timeOffset, time);
+    frameUniforms.upload();
+
+    const float CELL_SIZE = 2.0f / GRID_SIZE;
+    batchRenderer.begin();
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            const float color[4] = { r * x / GRID_SIZE, 0.2f, (float) y / GRID_SIZE, 1 };
+            batchRenderer.drawQuad(-1 + x * CELL_SIZE, -1 + y * CELL_SIZE, CELL_SIZE * 0.9f, CELL_SIZE * 0.9f, color);
+        }
+    }
+    batchRenderer.end();
+
+    //Rebind everything
+    if (shader.isReady()) {
+        if (!colorUniform.isValid())
+            colorUniform = shader.getUniform<Vec4>("uniColor"_u);
+        shader.bind();
+        shader.setUniform(colorUniform, Vec4{ r, 0.6f, 0.8f, 1 });
+    }
+
+    renderer.submit(va, ib, shader);
+    renderer.flush();
+    renderer.drawIndirect(instancedVa, ib, instancedShader, ringCommands);
+
+    if (r > 1)
+        increment = -0.05f;
+    else if (r < 0)
+        increment = 0.05f;
+    r += increment;
+
+    reportStats();
+}
+
+void DemoScene::reportStats() {
+    const BatchStats& batchStats = batchRenderer.getStats();
+    statsFrames++;
+    statsQuads += batchStats.quadCount;
+    statsDrawCalls += batchStats.drawCalls;
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - statsStartTime).count();
+    if (elapsed >= 1) {
+        cout << "Batch: " << (unsigned long long) (statsQuads / elapsed) << " quads/sec, "
+            << (double) statsDrawCalls / statsFrames << " draw calls/frame" << endl;
+        statsStartTime = now;
+        statsFrames = 0;
+        statsQuads = 0;
+        statsDrawCalls = 0;
+    }
+}
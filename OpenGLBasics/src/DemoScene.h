@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+
+#include "BatchRenderer.h"
+#include "IndexBuffer.h"
+#include "IndirectBuffer.h"
+#include "Renderer.h"
+#include "Shader.h"
+#include "UniformBuffer.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+/// <summary>
+/// Everything our demo draws each frame, so the windowed and headless modes can share it.
+/// </summary>
+//NOTE: Needs a current OpenGL context for as long as it's alive.
+class DemoScene {
+    public:
+    //A grid of GRID_SIZE x GRID_SIZE small quads, all drawn through the BatchRenderer
+    static const int GRID_SIZE = 200;
+
+    //A ring of small quads drawn with a single (indirect) instanced draw call, each with its own offset and color
+    static const int INSTANCE_COUNT = 32;
+
+    private:
+    //The big quad in the middle
+    VertexArray va;
+    VertexBuffer vb;
+    IndexBuffer ib;
+    Shader shader;
+    UniformHandle<Vec4> colorUniform; //Looked up once the shader's ready
+    float r;
+    float increment;
+
+    VertexArray instancedVa;
+    VertexBuffer instanceVb;
+    Shader instancedShader;
+    IndirectBuffer ringCommands; //Everything drawn with instancedVa and instancedShader, as one bucket (see Renderer::drawIndirect)
+
+    //Drawn in place of the shaders above until they're ready (see ShaderCompileMode::ASYNC)
+    Shader fallbackShader;
+
+    //Per-frame data every shader shares through the "Frame" uniform block, uploaded once per frame
+    Std140Layout frameLayout;
+    unsigned int tintOffset;
+    unsigned int timeOffset;
+    UniformBuffer frameUniforms;
+
+    Renderer renderer;
+    BatchRenderer batchRenderer;
+
+    std::chrono::steady_clock::time_point statsStartTime;
+    unsigned int statsFrames;
+    unsigned long long statsQuads;
+    unsigned long long statsDrawCalls;
+
+    public:
+    /// <param name="shaderMode">How to compile the scene's own shaders. The fallback shader (and the BatchRenderer's) are always compiled up front.</param>
+    DemoScene(ShaderCompileMode shaderMode = ShaderCompileMode::BLOCKING);
+
+    //Whether every shader's done compiling, so what we draw is what we meant to
+    bool isReady() const;
+
+    /// <param name="time">In seconds, since the start of the demo.</param>
+    void render(float time);
+
+    inline Renderer& getRenderer() { return renderer; }
+    inline const BatchStats& getBatchStats() const { return batchRenderer.getStats(); }
+
+    private:
+    void reportStats();
+};
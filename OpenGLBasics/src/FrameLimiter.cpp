@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "CpuProfiler.h"
+#include "FrameLimiter.h"
+#include "OpenGLUtil.h"
+
+using std::cout;
+using std::endl;
+
+FrameLimiter::FrameLimiter(unsigned int maxFramesInFlight)
+    : maxFramesInFlight(std::min(std::max(maxFramesInFlight, 1U), MAX_FRAMES_IN_FLIGHT)),
+    slot(0),
+    lastWaitTime(0),
+    totalWaitTime(0),
+    maxWaitTime(0),
+    frameCount(0),
+    waitCount(0) {
+    fences.resize(this->maxFramesInFlight, nullptr);
+}
+
+FrameLimiter::~FrameLimiter() {
+    for (GLsync fence : fences) {
+        if (fence != nullptr) {
+            GLCALL(glDeleteSync(fence));
+        }
+    }
+}
+
+void FrameLimiter::endFrame() {
+    //Everything for this frame (including the swap) has been issued by now, so the fence signals once the GPU's done with all of it.
+    GLCALL(fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    slot = (slot + 1) % maxFramesInFlight;
+
+    //NOTE: The slot we move on to holds the oldest frame still in flight (or this one, with 1 frame in flight).
+    lastWaitTime = 0;
+    GLsync fence = fences[slot];
+    if (fence != nullptr) {
+        wait(fence);
+        GLCALL(glDeleteSync(fence));
+        fences[slot] = nullptr;
+    }
+
+    frameCount++;
+    totalWaitTime += lastWaitTime;
+    maxWaitTime = std::max(maxWaitTime, lastWaitTime);
+}
+
+void FrameLimiter::wait(GLsync fence) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    GLenum result;
+    GLCALL(result = glClientWaitSync(fence, 0, 0));
+    if (result == GL_ALREADY_SIGNALED)
+        return;
+
+    PROFILE_SCOPE("Frame limiter wait");
+    waitCount++;
+
+    //NOTE: The first wait flushes, so the fence is sure to get to the GPU and we can't wait forever.
+    GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (true) {
+        GLCALL(result = glClientWaitSync(fence, waitFlags, 1000000)); //1ms, in nanoseconds
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+            break;
+        if (result == GL_WAIT_FAILED) {
+            ASSERT(false);
+            break;
+        }
+        waitFlags = 0;
+    }
+    lastWaitTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void FrameLimiter::print() const {
+    cout << "Frame limiter: " << maxFramesInFlight << " frame(s) in flight, waited on " << waitCount << " of " << frameCount << " frames, "
+        << totalWaitTime << " ms in total (" << (frameCount > 0 ? totalWaitTime / frameCount : 0) << " ms per frame, at most " << maxWaitTime << " ms)." << endl;
+}
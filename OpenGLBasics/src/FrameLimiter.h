@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <GL/glew.h>
+
+using std::vector;
+
+/// <summary>
+/// Caps how many frames the CPU can get ahead of the GPU. Left alone, the driver queues up as many frames as it likes,
+/// and each queued frame is another frame between reading input and showing its result.
+/// </summary>
+//NOTE: Each frame gets a fence after we swap. Once maxFramesInFlight frames are queued, endFrame() waits (on the CPU)
+//      for the oldest one to finish before we start the next, so the input we poll next is at most that many frames old.
+//      1 frame in flight has the least latency, but the CPU and GPU mostly take turns. More lets them overlap, for more throughput.
+//      How long we waited is recorded, so that trade-off can be measured (see getLastWaitTime(), and Benchmark).
+//
+//Usage, each frame:
+//      ...render, swap buffers...
+//      limiter.endFrame();
+//      ...poll events...
+class FrameLimiter {
+    public:
+    static const unsigned int MAX_FRAMES_IN_FLIGHT = 3;
+
+    private:
+    unsigned int maxFramesInFlight;
+    vector<GLsync> fences;  //One per frame in flight, or nullptr when there isn't one
+    unsigned int slot;      //Where this frame's fence goes
+
+    double lastWaitTime;    //All in milliseconds
+    double totalWaitTime;
+    double maxWaitTime;
+    unsigned int frameCount;
+    unsigned int waitCount; //Frames that actually had to wait
+
+    public:
+    /// <param name="maxFramesInFlight">From 1 to MAX_FRAMES_IN_FLIGHT (clamped).</param>
+    FrameLimiter(unsigned int maxFramesInFlight);
+    ~FrameLimiter();
+
+    //NOTE: Owns fences, so no copies.
+    FrameLimiter(const FrameLimiter&) = delete;
+    FrameLimiter& operator=(const FrameLimiter&) = delete;
+
+    /// <summary>
+    /// Fences the frame we just submitted, then waits for the GPU to finish the oldest frame, if there are too many in flight.
+    /// </summary>
+    void endFrame();
+
+    inline unsigned int getMaxFramesInFlight() const { return maxFramesInFlight; }
+
+    //How long the last endFrame() waited, in milliseconds
+    inline double getLastWaitTime() const { return lastWaitTime; }
+
+    /// <summary>
+    /// Prints how long we've waited overall (and per frame).
+    /// </summary>
+    void print() const;
+
+    private:
+    void wait(GLsync fence);
+};
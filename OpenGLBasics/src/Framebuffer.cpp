@@ -0,0 +1,48 @@
+#include <iostream>
+
+#include "OpenGLUtil.h"
+#include "Framebuffer.h"
+
+using std::cout;
+using std::endl;
+
+Framebuffer::Framebuffer(int width, int height)
+    : rendererId(0),
+    colorRenderbuffer(0),
+    width(width),
+    height(height) {
+
+    GLCALL(glGenRenderbuffers(1, &colorRenderbuffer));
+    GLCALL(glBindRenderbuffer(GL_RENDERBUFFER, colorRenderbuffer));
+    GLCALL(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height));
+
+    GLCALL(glGenFramebuffers(1, &rendererId));
+    bind();
+    GLCALL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRenderbuffer));
+
+    GLenum status;
+    GLCALL(status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        cout << "Framebuffer is incomplete! (" << status << ")" << endl;
+}
+
+Framebuffer::~Framebuffer() {
+    GLCALL(glDeleteFramebuffers(1, &rendererId));
+    GLCALL(glDeleteRenderbuffers(1, &colorRenderbuffer));
+}
+
+void Framebuffer::readPixels(vector<unsigned char>& pixels) const {
+    pixels.resize((size_t) width * height * 4);
+    bind();
+    GLCALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+    GLCALL(glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+}
+
+void Framebuffer::bind() const {
+    GLCALL(glBindFramebuffer(GL_FRAMEBUFFER, rendererId));
+    GLCALL(glViewport(0, 0, width, height));
+}
+
+void Framebuffer::unbind() const {
+    GLCALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
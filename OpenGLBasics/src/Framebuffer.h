@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+using std::vector;
+
+/// <summary>
+/// An offscreen render target (an FBO with an RGBA8 color renderbuffer), for rendering without a window.
+/// </summary>
+class Framebuffer {
+    private:
+    unsigned int rendererId;
+    unsigned int colorRenderbuffer;
+    int width;
+    int height;
+
+    public:
+    Framebuffer(int width, int height);
+    ~Framebuffer();
+
+    inline unsigned int getRendererId() const { return rendererId; }
+    inline int getWidth() const { return width; }
+    inline int getHeight() const { return height; }
+
+    /// <summary>
+    /// Reads back the color buffer as tightly packed RGBA8 rows, bottom row first (like OpenGL).
+    /// </summary>
+    void readPixels(vector<unsigned char>& pixels) const;
+
+    //NOTE: Binding also sets the viewport to cover the whole framebuffer.
+    void bind() const;
+    void unbind() const;
+};
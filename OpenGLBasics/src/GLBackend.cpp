@@ -0,0 +1,144 @@
+#include <cstdint>
+#include <cstring>
+
+#include "OpenGLUtil.h"
+#include "CpuProfiler.h"
+#include "GLBackend.h"
+#include "RenderStats.h"
+
+GLBackend::GLBackend(Framebuffer& target)
+    : target(target),
+    nextId(1),
+    frameConstants("FrameConstants", BACKEND_CONSTANT_COUNT * 4 * sizeof(float)) { }
+
+BufferHandle GLBackend::createBuffer(BufferType type, const void* data, unsigned int size) {
+    Buffer buffer;
+    buffer.type = type;
+    buffer.size = size;
+    if (type == BufferType::VERTEX) {
+        buffer.vertices.reset(new VertexBuffer(size));
+        if (data != nullptr)
+            buffer.vertices->setData(data, size);
+    } else {
+        ASSERT(data != nullptr);
+        buffer.indices.reset(new IndexBuffer((const unsigned int*) data, size / sizeof(unsigned int)));
+    }
+
+    BufferHandle handle = { nextId++ };
+    buffers[handle.id] = std::move(buffer);
+    return handle;
+}
+
+void GLBackend::updateBuffer(BufferHandle buffer, const void* data, unsigned int size, unsigned int offset) {
+    Buffer& existing = buffers.at(buffer.id);
+    ASSERT(existing.type == BufferType::VERTEX && offset + size <= existing.size);
+    existing.vertices->setData(data, size, offset);
+}
+
+void GLBackend::destroyBuffer(BufferHandle buffer) {
+    for (std::map<VertexArrayKey, unique_ptr<VertexArray>>::iterator it = vertexArrays.begin(); it != vertexArrays.end();) {
+        if (std::get<1>(it->first) == buffer.id || std::get<2>(it->first) == buffer.id)
+            it = vertexArrays.erase(it);
+        else
+            ++it;
+    }
+    buffers.erase(buffer.id);
+}
+
+PipelineHandle GLBackend::createPipeline(const PipelineDesc& desc) {
+    Pipeline pipeline;
+    pipeline.shader.reset(new Shader(desc.shaderPath));
+    pipeline.layout = desc.layout;
+    pipeline.drawConstants = pipeline.shader->getUniform<Vec4>("u_Draw"_u);
+
+    PipelineHandle handle = { nextId++ };
+    pipelines[handle.id] = std::move(pipeline);
+    return handle;
+}
+
+void GLBackend::destroyPipeline(PipelineHandle pipeline) {
+    for (std::map<VertexArrayKey, unique_ptr<VertexArray>>::iterator it = vertexArrays.begin(); it != vertexArrays.end();) {
+        if (std::get<0>(it->first) == pipeline.id)
+            it = vertexArrays.erase(it);
+        else
+            ++it;
+    }
+    pipelines.erase(pipeline.id);
+}
+
+CommandListHandle GLBackend::recordCommands(const vector<DrawCommand>& draws) {
+    vector<RecordedDraw> recorded;
+    recorded.reserve(draws.size());
+    for (const DrawCommand& command : draws)
+        recorded.push_back(record(command));
+
+    CommandListHandle handle = { nextId++ };
+    commandLists[handle.id] = std::move(recorded);
+    return handle;
+}
+
+void GLBackend::destroyCommands(CommandListHandle commands) {
+    commandLists.erase(commands.id);
+}
+
+void GLBackend::beginFrame(float r, float g, float b, float a) {
+    target.bind();
+    GLCALL(glClearColor(r, g, b, a));
+    GLCALL(glClear(GL_COLOR_BUFFER_BIT));
+}
+
+void GLBackend::setFrameConstants(const float constants[BACKEND_CONSTANT_COUNT][4]) {
+    frameConstants.set(0, constants, BACKEND_CONSTANT_COUNT * 4 * sizeof(float));
+    frameConstants.upload();
+    frameConstants.bind();
+}
+
+void GLBackend::submit(CommandListHandle commands) {
+    PROFILE_SCOPE("GLBackend::submit");
+    for (const RecordedDraw& draw : commandLists.at(commands.id))
+        execute(draw);
+}
+
+void GLBackend::draw(const DrawCommand& command) {
+    execute(record(command));
+}
+
+void GLBackend::endFrame() { }
+
+void GLBackend::readPixels(vector<unsigned char>& pixels) {
+    target.readPixels(pixels);
+}
+
+GLBackend::RecordedDraw GLBackend::record(const DrawCommand& command) {
+    Pipeline& pipeline = pipelines.at(command.pipeline.id);
+
+    VertexArrayKey key(command.pipeline.id, command.vertexBuffer.id, command.indexBuffer.id);
+    unique_ptr<VertexArray>& va = vertexArrays[key];
+    if (va == nullptr) {
+        Buffer& vertices = buffers.at(command.vertexBuffer.id);
+        Buffer& indices = buffers.at(command.indexBuffer.id);
+        ASSERT(vertices.type == BufferType::VERTEX && indices.type == BufferType::INDEX);
+
+        va.reset(new VertexArray());
+        va->addBuffer(*vertices.vertices, pipeline.layout);
+        indices.indices->bind(); //NOTE: Part of the VAO's state, since it's bound.
+    }
+
+    RecordedDraw draw;
+    draw.shader = pipeline.shader.get();
+    draw.va = va.get();
+    draw.drawConstants = pipeline.drawConstants;
+    draw.indexCount = command.indexCount;
+    draw.firstIndex = command.firstIndex;
+    memcpy(draw.constants, command.constants, sizeof(draw.constants));
+    return draw;
+}
+
+void GLBackend::execute(const RecordedDraw& draw) {
+    draw.shader->bind();
+    draw.va->bind();
+    draw.shader->setUniform(draw.drawConstants, (const Vec4*) &draw.constants[0][0], BACKEND_CONSTANT_COUNT);
+
+    GLCALL(glDrawElements(GL_TRIANGLES, draw.indexCount, GL_UNSIGNED_INT, (const void*) (uintptr_t) (draw.firstIndex * sizeof(unsigned int))));
+    RenderStats::get().onDraw(draw.indexCount / 3);
+}
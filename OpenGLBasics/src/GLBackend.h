@@ -0,0 +1,89 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+
+#include "Framebuffer.h"
+#include "IndexBuffer.h"
+#include "RenderBackend.h"
+#include "Shader.h"
+#include "UniformBuffer.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+using std::unique_ptr;
+
+/// <summary>
+/// The RenderBackend for OpenGL, built on our usual VertexBuffer, IndexBuffer, VertexArray and Shader classes (so it shares the GLStateCache too).
+/// Renders into a Framebuffer.
+/// </summary>
+//NOTE: Needs a current OpenGL context for as long as it's alive.
+//      OpenGL ties vertex buffers to a layout through a VAO, so we make one per (pipeline, vertex buffer, index buffer) the first time a draw uses them.
+//      Recording a command list does that (and looks up the u_Draw uniform), so submitting it is just binds, the u_Draw upload (skipped when it's unchanged) and the draw.
+class GLBackend : public RenderBackend {
+    private:
+    struct Buffer {
+        BufferType type;
+        unsigned int size;
+        unique_ptr<VertexBuffer> vertices;
+        unique_ptr<IndexBuffer> indices;
+    };
+
+    struct Pipeline {
+        unique_ptr<Shader> shader;
+        VertexBufferLayout layout;
+        UniformHandle<Vec4> drawConstants; //Invalid if the shader doesn't use any
+    };
+
+    //A DrawCommand with everything already looked up
+    struct RecordedDraw {
+        Shader* shader;
+        const VertexArray* va;
+        UniformHandle<Vec4> drawConstants;
+        unsigned int indexCount;
+        unsigned int firstIndex;
+        float constants[BACKEND_CONSTANT_COUNT][4];
+    };
+
+    //(pipeline, vertex buffer, index buffer)
+    typedef std::tuple<unsigned int, unsigned int, unsigned int> VertexArrayKey;
+
+    Framebuffer& target;
+    unsigned int nextId;
+
+    unordered_map<unsigned int, Buffer> buffers;
+    unordered_map<unsigned int, Pipeline> pipelines;
+    std::map<VertexArrayKey, unique_ptr<VertexArray>> vertexArrays;
+    unordered_map<unsigned int, vector<RecordedDraw>> commandLists;
+
+    UniformBuffer frameConstants;
+
+    public:
+    GLBackend(Framebuffer& target);
+
+    const char* getName() const override { return "OpenGL"; }
+
+    BufferHandle createBuffer(BufferType type, const void* data, unsigned int size) override;
+    void updateBuffer(BufferHandle buffer, const void* data, unsigned int size, unsigned int offset = 0) override;
+    void destroyBuffer(BufferHandle buffer) override;
+
+    PipelineHandle createPipeline(const PipelineDesc& desc) override;
+    void destroyPipeline(PipelineHandle pipeline) override;
+
+    CommandListHandle recordCommands(const vector<DrawCommand>& draws) override;
+    void destroyCommands(CommandListHandle commands) override;
+
+    void beginFrame(float r, float g, float b, float a) override;
+    void setFrameConstants(const float constants[BACKEND_CONSTANT_COUNT][4]) override;
+    void submit(CommandListHandle commands) override;
+    void draw(const DrawCommand& command) override;
+    void endFrame() override;
+
+    void readPixels(vector<unsigned char>& pixels) override;
+
+    private:
+    RecordedDraw record(const DrawCommand& command);
+    void execute(const RecordedDraw& draw);
+};
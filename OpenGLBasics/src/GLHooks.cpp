@@ -0,0 +1,18 @@
+//NOTE: We need the real function names here.
+#define GL_HOOKS_IMPLEMENTATION
+#include "GLHooks.h"
+
+decltype(&glBindTexture) glhBindTexture = &glBindTexture;
+decltype(&glClear) glhClear = &glClear;
+decltype(&glClearColor) glhClearColor = &glClearColor;
+decltype(&glDisable) glhDisable = &glDisable;
+decltype(&glDrawElements) glhDrawElements = &glDrawElements;
+decltype(&glEnable) glhEnable = &glEnable;
+decltype(&glFinish) glhFinish = &glFinish;
+decltype(&glFlush) glhFlush = &glFlush;
+decltype(&glGetError) glhGetError = &glGetError;
+decltype(&glGetIntegerv) glhGetIntegerv = &glGetIntegerv;
+decltype(&glGetString) glhGetString = &glGetString;
+decltype(&glPixelStorei) glhPixelStorei = &glPixelStorei;
+decltype(&glReadPixels) glhReadPixels = &glReadPixels;
+decltype(&glViewport) glhViewport = &glViewport;
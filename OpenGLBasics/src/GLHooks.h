@@ -0,0 +1,40 @@
+#pragma once
+
+#include <GL/glew.h>
+
+//Function pointers for the OpenGL 1.1 functions we use, so they can be swapped out at runtime like everything else (see GLTrace).
+//NOTE: GLEW already calls everything newer than OpenGL 1.1 through function pointers (e.g. glBufferData is really __glewBufferData),
+//      but OpenGL 1.1 functions are linked directly, so there'd be no way to intercept them.
+//      OpenGLUtil.h includes this, so every call we make through it goes through these pointers. Each one starts out pointing at the real function.
+extern decltype(&glBindTexture) glhBindTexture;
+extern decltype(&glClear) glhClear;
+extern decltype(&glClearColor) glhClearColor;
+extern decltype(&glDisable) glhDisable;
+extern decltype(&glDrawElements) glhDrawElements;
+extern decltype(&glEnable) glhEnable;
+extern decltype(&glFinish) glhFinish;
+extern decltype(&glFlush) glhFlush;
+extern decltype(&glGetError) glhGetError;
+extern decltype(&glGetIntegerv) glhGetIntegerv;
+extern decltype(&glGetString) glhGetString;
+extern decltype(&glPixelStorei) glhPixelStorei;
+extern decltype(&glReadPixels) glhReadPixels;
+extern decltype(&glViewport) glhViewport;
+
+//NOTE: Defined after the declarations above (and after glew.h), so those still refer to the real functions.
+#ifndef GL_HOOKS_IMPLEMENTATION
+#define glBindTexture glhBindTexture
+#define glClear glhClear
+#define glClearColor glhClearColor
+#define glDisable glhDisable
+#define glDrawElements glhDrawElements
+#define glEnable glhEnable
+#define glFinish glhFinish
+#define glFlush glhFlush
+#define glGetError glhGetError
+#define glGetIntegerv glhGetIntegerv
+#define glGetString glhGetString
+#define glPixelStorei glhPixelStorei
+#define glReadPixels glhReadPixels
+#define glViewport glhViewport
+#endif
@@ -0,0 +1,165 @@
+#include "OpenGLUtil.h"
+#include "GLStateCache.h"
+#include "RenderStats.h"
+
+GLStateCache& GLStateCache::get() {
+    static GLStateCache cache;
+    return cache;
+}
+
+GLStateCache::GLStateCache()
+    : issuedCalls(0),
+    skippedCalls(0) {
+    invalidate();
+}
+
+void GLStateCache::useProgram(unsigned int id) {
+    if (program == id) {
+        skippedCalls++;
+        return;
+    }
+    GLCALL(glUseProgram(id));
+    program = id;
+    issuedCalls++;
+    RenderStats::get().onProgramBind();
+}
+
+void GLStateCache::bindVertexArray(unsigned int id) {
+    if (vertexArray == id) {
+        skippedCalls++;
+        return;
+    }
+    GLCALL(glBindVertexArray(id));
+    vertexArray = id;
+    issuedCalls++;
+    RenderStats::get().onVertexArrayBind();
+}
+
+void GLStateCache::bindBuffer(unsigned int target, unsigned int id) {
+    if (target == GL_ELEMENT_ARRAY_BUFFER && vertexArray != UNKNOWN) {
+        unordered_map<unsigned int, unsigned int>::iterator it = elementBuffers.find(vertexArray);
+        if (it != elementBuffers.end() && it->second == id) {
+            skippedCalls++;
+            return;
+        }
+        GLCALL(glBindBuffer(target, id));
+        elementBuffers[vertexArray] = id;
+        issuedCalls++;
+        RenderStats::get().onBufferBind();
+        return;
+    }
+
+    unsigned int* slot = getBufferSlot(target);
+    if (slot != nullptr && *slot == id) {
+        skippedCalls++;
+        return;
+    }
+    GLCALL(glBindBuffer(target, id));
+    if (slot != nullptr)
+        *slot = id;
+    issuedCalls++;
+    RenderStats::get().onBufferBind();
+}
+
+void GLStateCache::bindBufferBase(unsigned int target, unsigned int index, unsigned int id) {
+    uint64_t key = ((uint64_t) target << 32) | index;
+    unordered_map<uint64_t, unsigned int>::iterator it = indexedBuffers.find(key);
+    if (it != indexedBuffers.end() && it->second == id) {
+        skippedCalls++;
+        return;
+    }
+    GLCALL(glBindBufferBase(target, index, id));
+    indexedBuffers[key] = id;
+    issuedCalls++;
+    RenderStats::get().onBufferBind();
+
+    //NOTE: glBindBufferBase binds to the generic target as well.
+    unsigned int* slot = getBufferSlot(target);
+    if (slot != nullptr)
+        *slot = id;
+}
+
+void GLStateCache::activeTexture(unsigned int unit) {
+    if (activeTextureUnit == unit) {
+        skippedCalls++;
+        return;
+    }
+    GLCALL(glActiveTexture(GL_TEXTURE0 + unit));
+    activeTextureUnit = unit;
+    issuedCalls++;
+}
+
+void GLStateCache::bindTexture(unsigned int unit, unsigned int target, unsigned int id) {
+    uint64_t key = ((uint64_t) unit << 32) | target;
+    unordered_map<uint64_t, unsigned int>::iterator it = textures.find(key);
+    if (it != textures.end() && it->second == id) {
+        skippedCalls++;
+        return;
+    }
+    activeTexture(unit);
+    GLCALL(glBindTexture(target, id));
+    textures[key] = id;
+    issuedCalls++;
+}
+
+void GLStateCache::onProgramDeleted(unsigned int id) {
+    //NOTE: Deleting the program in use doesn't unbind it (OpenGL defers the delete), but the name can be reused.
+    if (program == id)
+        program = UNKNOWN;
+}
+
+void GLStateCache::onVertexArrayDeleted(unsigned int id) {
+    if (vertexArray == id)
+        vertexArray = UNKNOWN;
+    elementBuffers.erase(id);
+}
+
+void GLStateCache::onBufferDeleted(unsigned int id) {
+    for (unsigned int i = 0; i < BUFFER_TARGET_COUNT; i++) {
+        if (buffers[i] == id)
+            buffers[i] = UNKNOWN;
+    }
+    for (std::pair<const unsigned int, unsigned int>& binding : elementBuffers) {
+        if (binding.second == id)
+            binding.second = UNKNOWN;
+    }
+    for (std::pair<const uint64_t, unsigned int>& binding : indexedBuffers) {
+        if (binding.second == id)
+            binding.second = UNKNOWN;
+    }
+}
+
+void GLStateCache::onTextureDeleted(unsigned int id) {
+    for (std::pair<const uint64_t, unsigned int>& binding : textures) {
+        if (binding.second == id)
+            binding.second = UNKNOWN;
+    }
+}
+
+void GLStateCache::invalidate() {
+    program = UNKNOWN;
+    vertexArray = UNKNOWN;
+    for (unsigned int i = 0; i < BUFFER_TARGET_COUNT; i++)
+        buffers[i] = UNKNOWN;
+    elementBuffers.clear();
+    indexedBuffers.clear();
+    activeTextureUnit = UNKNOWN;
+    textures.clear();
+}
+
+void GLStateCache::resetCounters() {
+    issuedCalls = 0;
+    skippedCalls = 0;
+}
+
+unsigned int* GLStateCache::getBufferSlot(unsigned int target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER:           return &buffers[0];
+        case GL_UNIFORM_BUFFER:         return &buffers[1];
+        case GL_DRAW_INDIRECT_BUFFER:   return &buffers[2];
+        case GL_COPY_READ_BUFFER:       return &buffers[3];
+        case GL_COPY_WRITE_BUFFER:      return &buffers[4];
+        case GL_PIXEL_UNPACK_BUFFER:    return &buffers[5];
+    }
+    return nullptr;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+using std::unordered_map;
+
+/// <summary>
+/// A CPU-side shadow of the OpenGL binding state (program, VAO, buffers, textures) for our context.
+/// All binds go through here so we can skip any call that wouldn't change anything.
+/// </summary>
+//NOTE: OpenGL state belongs to a context, and we only ever create one, so there's just one cache (see get()).
+//      If anything else touches GL bindings behind our back (or we switch contexts), call invalidate().
+class GLStateCache {
+    private:
+    //NOTE: Used for any binding we can't be sure of, so the next bind always goes through to OpenGL.
+    static const unsigned int UNKNOWN = 0xFFFFFFFF;
+
+    static const unsigned int BUFFER_TARGET_COUNT = 6;
+
+    unsigned int program;
+    unsigned int vertexArray;
+    unsigned int buffers[BUFFER_TARGET_COUNT];
+
+    //NOTE: The GL_ELEMENT_ARRAY_BUFFER binding is part of the VAO's state, so we remember it per VAO.
+    unordered_map<unsigned int, unsigned int> elementBuffers;
+
+    unordered_map<uint64_t, unsigned int> indexedBuffers; //(target << 32 | index) => buffer, for glBindBufferBase
+
+    unsigned int activeTextureUnit;
+    unordered_map<uint64_t, unsigned int> textures; //(unit << 32 | target) => texture
+
+    uint64_t issuedCalls;
+    uint64_t skippedCalls;
+
+    public:
+    static GLStateCache& get();
+
+    GLStateCache();
+
+    void useProgram(unsigned int id);
+    void bindVertexArray(unsigned int id);
+    void bindBuffer(unsigned int target, unsigned int id);
+    void bindBufferBase(unsigned int target, unsigned int index, unsigned int id);
+    void activeTexture(unsigned int unit);
+    void bindTexture(unsigned int unit, unsigned int target, unsigned int id);
+
+    //NOTE: Call these right after deleting an object, since OpenGL may recycle its name for the next object we create.
+    void onProgramDeleted(unsigned int id);
+    void onVertexArrayDeleted(unsigned int id);
+    void onBufferDeleted(unsigned int id);
+    void onTextureDeleted(unsigned int id);
+
+    /// <summary>
+    /// Forgets everything we know, so that every following bind is issued to OpenGL.
+    /// </summary>
+    void invalidate();
+
+    inline uint64_t getIssuedCalls() const { return issuedCalls; }
+    inline uint64_t getSkippedCalls() const { return skippedCalls; }
+    void resetCounters();
+
+    private:
+    //Returns nullptr for targets we don't track.
+    unsigned int* getBufferSlot(unsigned int target);
+};
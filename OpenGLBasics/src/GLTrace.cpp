@@ -0,0 +1,967 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "OpenGLUtil.h"
+#include "GLTrace.h"
+#include "GLTraceFormat.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+bool GLTrace::capturing = false;
+
+//NOTE: Records go into memory first, and only hit the file every few MB, so capturing doesn't turn every GL call into a write.
+static const size_t FLUSH_SIZE = 4 * 1024 * 1024;
+
+static std::ofstream traceFile;
+static vector<char> traceData;
+static size_t recordStart = SIZE_MAX; //Where the record we're writing starts in traceData, so we can fill in its size once it's done
+
+static void writeBytes(const void* data, size_t size) {
+    const char* bytes = (const char*) data;
+    traceData.insert(traceData.end(), bytes, bytes + size);
+}
+
+static void finishRecord() {
+    if (recordStart == SIZE_MAX)
+        return;
+    uint32_t size = (uint32_t) (traceData.size() - recordStart - 5);
+    memcpy(&traceData[recordStart + 1], &size, 4);
+    recordStart = SIZE_MAX;
+}
+
+static void flushTrace() {
+    finishRecord();
+    traceFile.write(traceData.data(), traceData.size());
+    traceData.clear();
+}
+
+//Starts a new record, which lasts until the next one starts.
+static void writeOp(GLTraceOp op) {
+    finishRecord();
+    if (traceData.size() >= FLUSH_SIZE)
+        flushTrace();
+
+    recordStart = traceData.size();
+    uint8_t value = op;
+    uint32_t size = 0;
+    writeBytes(&value, 1);
+    writeBytes(&size, 4);
+}
+
+static void write32(uint32_t value) {
+    writeBytes(&value, 4);
+}
+
+static void write64(uint64_t value) {
+    writeBytes(&value, 8);
+}
+
+static void writeFloat(float value) {
+    writeBytes(&value, 4);
+}
+
+static void writePayload(const void* data, size_t size) {
+    if (data == nullptr) {
+        write32(GL_TRACE_NULL_PAYLOAD);
+        return;
+    }
+    write32((uint32_t) size);
+    writeBytes(data, size);
+}
+
+//Every function we capture: the pointer we swap out, and the name of our real##name / trace##name pair.
+#define GL_TRACE_HOOKS(HOOK) \
+    HOOK(__glewGenBuffers, GenBuffers) \
+    HOOK(__glewDeleteBuffers, DeleteBuffers) \
+    HOOK(__glewBindBuffer, BindBuffer) \
+    HOOK(__glewBindBufferBase, BindBufferBase) \
+    HOOK(__glewBufferData, BufferData) \
+    HOOK(__glewBufferSubData, BufferSubData) \
+    HOOK(__glewBufferStorage, BufferStorage) \
+    HOOK(__glewMapBufferRange, MapBufferRange) \
+    HOOK(__glewUnmapBuffer, UnmapBuffer) \
+    HOOK(__glewGenVertexArrays, GenVertexArrays) \
+    HOOK(__glewDeleteVertexArrays, DeleteVertexArrays) \
+    HOOK(__glewBindVertexArray, BindVertexArray) \
+    HOOK(__glewEnableVertexAttribArray, EnableVertexAttribArray) \
+    HOOK(__glewVertexAttribPointer, VertexAttribPointer) \
+    HOOK(__glewVertexAttribDivisor, VertexAttribDivisor) \
+    HOOK(__glewCreateShader, CreateShader) \
+    HOOK(__glewShaderSource, ShaderSource) \
+    HOOK(__glewCompileShader, CompileShader) \
+    HOOK(__glewDeleteShader, DeleteShader) \
+    HOOK(__glewCreateProgram, CreateProgram) \
+    HOOK(__glewAttachShader, AttachShader) \
+    HOOK(__glewLinkProgram, LinkProgram) \
+    HOOK(__glewValidateProgram, ValidateProgram) \
+    HOOK(__glewDeleteProgram, DeleteProgram) \
+    HOOK(__glewUseProgram, UseProgram) \
+    HOOK(__glewGetUniformLocation, GetUniformLocation) \
+    HOOK(__glewUniform1i, Uniform1i) \
+    HOOK(__glewUniform1f, Uniform1f) \
+    HOOK(__glewUniform4f, Uniform4f) \
+    HOOK(__glewUniform1iv, Uniform1iv) \
+    HOOK(__glewUniform4fv, Uniform4fv) \
+    HOOK(__glewUniformMatrix4fv, UniformMatrix4fv) \
+    HOOK(__glewUniform1fv, Uniform1fv) \
+    HOOK(__glewUniform2fv, Uniform2fv) \
+    HOOK(__glewUniform3fv, Uniform3fv) \
+    HOOK(__glewUniform2iv, Uniform2iv) \
+    HOOK(__glewUniform3iv, Uniform3iv) \
+    HOOK(__glewUniform4iv, Uniform4iv) \
+    HOOK(__glewUniform1uiv, Uniform1uiv) \
+    HOOK(__glewUniform2uiv, Uniform2uiv) \
+    HOOK(__glewUniform3uiv, Uniform3uiv) \
+    HOOK(__glewUniform4uiv, Uniform4uiv) \
+    HOOK(__glewUniformMatrix2fv, UniformMatrix2fv) \
+    HOOK(__glewUniformMatrix3fv, UniformMatrix3fv) \
+    HOOK(__glewUniformMatrix2x3fv, UniformMatrix2x3fv) \
+    HOOK(__glewUniformMatrix2x4fv, UniformMatrix2x4fv) \
+    HOOK(__glewUniformMatrix3x2fv, UniformMatrix3x2fv) \
+    HOOK(__glewUniformMatrix3x4fv, UniformMatrix3x4fv) \
+    HOOK(__glewUniformMatrix4x2fv, UniformMatrix4x2fv) \
+    HOOK(__glewUniformMatrix4x3fv, UniformMatrix4x3fv) \
+    HOOK(__glewUniform1dv, Uniform1dv) \
+    HOOK(__glewUniform2dv, Uniform2dv) \
+    HOOK(__glewUniform3dv, Uniform3dv) \
+    HOOK(__glewUniform4dv, Uniform4dv) \
+    HOOK(__glewUniformMatrix2dv, UniformMatrix2dv) \
+    HOOK(__glewUniformMatrix3dv, UniformMatrix3dv) \
+    HOOK(__glewUniformMatrix4dv, UniformMatrix4dv) \
+    HOOK(__glewUniformMatrix2x3dv, UniformMatrix2x3dv) \
+    HOOK(__glewUniformMatrix2x4dv, UniformMatrix2x4dv) \
+    HOOK(__glewUniformMatrix3x2dv, UniformMatrix3x2dv) \
+    HOOK(__glewUniformMatrix3x4dv, UniformMatrix3x4dv) \
+    HOOK(__glewUniformMatrix4x2dv, UniformMatrix4x2dv) \
+    HOOK(__glewUniformMatrix4x3dv, UniformMatrix4x3dv) \
+    HOOK(__glewUniformBlockBinding, UniformBlockBinding) \
+    HOOK(__glewGenFramebuffers, GenFramebuffers) \
+    HOOK(__glewDeleteFramebuffers, DeleteFramebuffers) \
+    HOOK(__glewBindFramebuffer, BindFramebuffer) \
+    HOOK(__glewGenRenderbuffers, GenRenderbuffers) \
+    HOOK(__glewDeleteRenderbuffers, DeleteRenderbuffers) \
+    HOOK(__glewBindRenderbuffer, BindRenderbuffer) \
+    HOOK(__glewRenderbufferStorage, RenderbufferStorage) \
+    HOOK(__glewFramebufferRenderbuffer, FramebufferRenderbuffer) \
+    HOOK(__glewActiveTexture, ActiveTexture) \
+    HOOK(glhBindTexture, BindTexture) \
+    HOOK(glhClear, Clear) \
+    HOOK(glhClearColor, ClearColor) \
+    HOOK(glhViewport, Viewport) \
+    HOOK(glhEnable, Enable) \
+    HOOK(glhDisable, Disable) \
+    HOOK(glhPixelStorei, PixelStorei) \
+    HOOK(glhDrawElements, DrawElements) \
+    HOOK(__glewDrawElementsInstanced, DrawElementsInstanced) \
+    HOOK(__glewDrawElementsInstancedBaseInstance, DrawElementsInstancedBaseInstance) \
+    HOOK(__glewDrawElementsBaseVertex, DrawElementsBaseVertex) \
+    HOOK(__glewDrawElementsInstancedBaseVertex, DrawElementsInstancedBaseVertex) \
+    HOOK(__glewDrawElementsInstancedBaseVertexBaseInstance, DrawElementsInstancedBaseVertexBaseInstance) \
+    HOOK(__glewMultiDrawElementsBaseVertex, MultiDrawElementsBaseVertex) \
+    HOOK(__glewMultiDrawElementsIndirect, MultiDrawElementsIndirect) \
+    HOOK(__glewFenceSync, FenceSync) \
+    HOOK(__glewClientWaitSync, ClientWaitSync) \
+    HOOK(__glewDeleteSync, DeleteSync) \
+    HOOK(glhFlush, Flush) \
+    HOOK(glhFinish, Finish)
+
+#define DECLARE_REAL(pointer, name) static decltype(pointer) real##name = nullptr;
+GL_TRACE_HOOKS(DECLARE_REAL)
+#undef DECLARE_REAL
+
+//Records a glGen* call's (or glDelete*'s) names.
+static void writeNames(GLTraceOp op, GLsizei n, const GLuint* names) {
+    writeOp(op);
+    write32(n);
+    for (GLsizei i = 0; i < n; i++)
+        write32(names[i]);
+}
+
+static void GLAPIENTRY traceGenBuffers(GLsizei n, GLuint* buffers) {
+    realGenBuffers(n, buffers);
+    writeNames(GL_TRACE_GEN_BUFFERS, n, buffers);
+}
+
+static void GLAPIENTRY traceDeleteBuffers(GLsizei n, const GLuint* buffers) {
+    realDeleteBuffers(n, buffers);
+    writeNames(GL_TRACE_DELETE_BUFFERS, n, buffers);
+}
+
+static void GLAPIENTRY traceBindBuffer(GLenum target, GLuint buffer) {
+    realBindBuffer(target, buffer);
+    writeOp(GL_TRACE_BIND_BUFFER);
+    write32(target);
+    write32(buffer);
+}
+
+static void GLAPIENTRY traceBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    realBindBufferBase(target, index, buffer);
+    writeOp(GL_TRACE_BIND_BUFFER_BASE);
+    write32(target);
+    write32(index);
+    write32(buffer);
+}
+
+static void GLAPIENTRY traceBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    realBufferData(target, size, data, usage);
+    writeOp(GL_TRACE_BUFFER_DATA);
+    write32(target);
+    write64(size);
+    writePayload(data, size);
+    write32(usage);
+}
+
+static void GLAPIENTRY traceBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    realBufferSubData(target, offset, size, data);
+    writeOp(GL_TRACE_BUFFER_SUB_DATA);
+    write32(target);
+    write64(offset);
+    writePayload(data, size);
+}
+
+static void GLAPIENTRY traceBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+    realBufferStorage(target, size, data, flags);
+    writeOp(GL_TRACE_BUFFER_STORAGE);
+    write32(target);
+    write64(size);
+    writePayload(data, size);
+    write32(flags);
+}
+
+static void* GLAPIENTRY traceMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    void* pointer = realMapBufferRange(target, offset, length, access);
+    writeOp(GL_TRACE_MAP_BUFFER_RANGE);
+    write32(target);
+    write64(offset);
+    write64(length);
+    write32(access);
+    return pointer;
+}
+
+static GLboolean GLAPIENTRY traceUnmapBuffer(GLenum target) {
+    GLboolean result = realUnmapBuffer(target);
+    writeOp(GL_TRACE_UNMAP_BUFFER);
+    write32(target);
+    return result;
+}
+
+static void GLAPIENTRY traceGenVertexArrays(GLsizei n, GLuint* arrays) {
+    realGenVertexArrays(n, arrays);
+    writeNames(GL_TRACE_GEN_VERTEX_ARRAYS, n, arrays);
+}
+
+static void GLAPIENTRY traceDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    realDeleteVertexArrays(n, arrays);
+    writeNames(GL_TRACE_DELETE_VERTEX_ARRAYS, n, arrays);
+}
+
+static void GLAPIENTRY traceBindVertexArray(GLuint array) {
+    realBindVertexArray(array);
+    writeOp(GL_TRACE_BIND_VERTEX_ARRAY);
+    write32(array);
+}
+
+static void GLAPIENTRY traceEnableVertexAttribArray(GLuint index) {
+    realEnableVertexAttribArray(index);
+    writeOp(GL_TRACE_ENABLE_VERTEX_ATTRIB_ARRAY);
+    write32(index);
+}
+
+static void GLAPIENTRY traceVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer) {
+    realVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    writeOp(GL_TRACE_VERTEX_ATTRIB_POINTER);
+    write32(index);
+    write32(size);
+    write32(type);
+    write32(normalized);
+    write32(stride);
+    write64((uintptr_t) pointer);
+}
+
+static void GLAPIENTRY traceVertexAttribDivisor(GLuint index, GLuint divisor) {
+    realVertexAttribDivisor(index, divisor);
+    writeOp(GL_TRACE_VERTEX_ATTRIB_DIVISOR);
+    write32(index);
+    write32(divisor);
+}
+
+static GLuint GLAPIENTRY traceCreateShader(GLenum type) {
+    GLuint shader = realCreateShader(type);
+    writeOp(GL_TRACE_CREATE_SHADER);
+    write32(type);
+    write32(shader);
+    return shader;
+}
+
+static void GLAPIENTRY traceShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths) {
+    realShaderSource(shader, count, strings, lengths);
+    writeOp(GL_TRACE_SHADER_SOURCE);
+    write32(shader);
+    write32(count);
+    for (GLsizei i = 0; i < count; i++) {
+        //NOTE: No lengths (or a negative one) means the string is null-terminated.
+        size_t length = (lengths != nullptr && lengths[i] >= 0) ? (size_t) lengths[i] : strlen(strings[i]);
+        writePayload(strings[i], length);
+    }
+}
+
+static void GLAPIENTRY traceCompileShader(GLuint shader) {
+    realCompileShader(shader);
+    writeOp(GL_TRACE_COMPILE_SHADER);
+    write32(shader);
+}
+
+static void GLAPIENTRY traceDeleteShader(GLuint shader) {
+    realDeleteShader(shader);
+    writeOp(GL_TRACE_DELETE_SHADER);
+    write32(shader);
+}
+
+static GLuint GLAPIENTRY traceCreateProgram() {
+    GLuint program = realCreateProgram();
+    writeOp(GL_TRACE_CREATE_PROGRAM);
+    write32(program);
+    return program;
+}
+
+static void GLAPIENTRY traceAttachShader(GLuint program, GLuint shader) {
+    realAttachShader(program, shader);
+    writeOp(GL_TRACE_ATTACH_SHADER);
+    write32(program);
+    write32(shader);
+}
+
+static void GLAPIENTRY traceLinkProgram(GLuint program) {
+    realLinkProgram(program);
+    writeOp(GL_TRACE_LINK_PROGRAM);
+    write32(program);
+}
+
+static void GLAPIENTRY traceValidateProgram(GLuint program) {
+    realValidateProgram(program);
+    writeOp(GL_TRACE_VALIDATE_PROGRAM);
+    write32(program);
+}
+
+static void GLAPIENTRY traceDeleteProgram(GLuint program) {
+    realDeleteProgram(program);
+    writeOp(GL_TRACE_DELETE_PROGRAM);
+    write32(program);
+}
+
+static void GLAPIENTRY traceUseProgram(GLuint program) {
+    realUseProgram(program);
+    writeOp(GL_TRACE_USE_PROGRAM);
+    write32(program);
+}
+
+static GLint GLAPIENTRY traceGetUniformLocation(GLuint program, const GLchar* name) {
+    GLint location = realGetUniformLocation(program, name);
+    writeOp(GL_TRACE_GET_UNIFORM_LOCATION);
+    write32(program);
+    writePayload(name, strlen(name) + 1);
+    write32((uint32_t) location);
+    return location;
+}
+
+static void GLAPIENTRY traceUniform1i(GLint location, GLint v0) {
+    realUniform1i(location, v0);
+    writeOp(GL_TRACE_UNIFORM_1I);
+    write32((uint32_t) location);
+    write32((uint32_t) v0);
+}
+
+static void GLAPIENTRY traceUniform1f(GLint location, GLfloat v0) {
+    realUniform1f(location, v0);
+    writeOp(GL_TRACE_UNIFORM_1F);
+    write32((uint32_t) location);
+    writeFloat(v0);
+}
+
+static void GLAPIENTRY traceUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    realUniform4f(location, v0, v1, v2, v3);
+    writeOp(GL_TRACE_UNIFORM_4F);
+    write32((uint32_t) location);
+    writeFloat(v0);
+    writeFloat(v1);
+    writeFloat(v2);
+    writeFloat(v3);
+}
+
+static void GLAPIENTRY traceUniform1iv(GLint location, GLsizei count, const GLint* value) {
+    realUniform1iv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_1IV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * sizeof(GLint));
+}
+
+static void GLAPIENTRY traceUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+    realUniform4fv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_4FV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 4 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix4fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_4FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 16 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniform1fv(GLint location, GLsizei count, const GLfloat* value) {
+    realUniform1fv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_1FV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniform2fv(GLint location, GLsizei count, const GLfloat* value) {
+    realUniform2fv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_2FV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 2 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+    realUniform3fv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_3FV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 3 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniform2iv(GLint location, GLsizei count, const GLint* value) {
+    realUniform2iv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_2IV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 2 * sizeof(GLint));
+}
+
+static void GLAPIENTRY traceUniform3iv(GLint location, GLsizei count, const GLint* value) {
+    realUniform3iv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_3IV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 3 * sizeof(GLint));
+}
+
+static void GLAPIENTRY traceUniform4iv(GLint location, GLsizei count, const GLint* value) {
+    realUniform4iv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_4IV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 4 * sizeof(GLint));
+}
+
+static void GLAPIENTRY traceUniform1uiv(GLint location, GLsizei count, const GLuint* value) {
+    realUniform1uiv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_1UIV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * sizeof(GLuint));
+}
+
+static void GLAPIENTRY traceUniform2uiv(GLint location, GLsizei count, const GLuint* value) {
+    realUniform2uiv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_2UIV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 2 * sizeof(GLuint));
+}
+
+static void GLAPIENTRY traceUniform3uiv(GLint location, GLsizei count, const GLuint* value) {
+    realUniform3uiv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_3UIV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 3 * sizeof(GLuint));
+}
+
+static void GLAPIENTRY traceUniform4uiv(GLint location, GLsizei count, const GLuint* value) {
+    realUniform4uiv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_4UIV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 4 * sizeof(GLuint));
+}
+
+static void GLAPIENTRY traceUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix2fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_2FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 4 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix3fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_3FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 9 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix2x3fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_2X3FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 6 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix2x4fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_2X4FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 8 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix3x2fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_3X2FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 6 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix3x4fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_3X4FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 12 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix4x2fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_4X2FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 8 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    realUniformMatrix4x3fv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_4X3FV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 12 * sizeof(GLfloat));
+}
+
+static void GLAPIENTRY traceUniform1dv(GLint location, GLsizei count, const GLdouble* value) {
+    realUniform1dv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_1DV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniform2dv(GLint location, GLsizei count, const GLdouble* value) {
+    realUniform2dv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_2DV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 2 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniform3dv(GLint location, GLsizei count, const GLdouble* value) {
+    realUniform3dv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_3DV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 3 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniform4dv(GLint location, GLsizei count, const GLdouble* value) {
+    realUniform4dv(location, count, value);
+    writeOp(GL_TRACE_UNIFORM_4DV);
+    write32((uint32_t) location);
+    write32(count);
+    writePayload(value, count * 4 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix2dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_2DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 4 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix3dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_3DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 9 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix4dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_4DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 16 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix2x3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix2x3dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_2X3DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 6 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix2x4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix2x4dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_2X4DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 8 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix3x2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix3x2dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_3X2DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 6 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix3x4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix3x4dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_3X4DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 12 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix4x2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix4x2dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_4X2DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 8 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformMatrix4x3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble* value) {
+    realUniformMatrix4x3dv(location, count, transpose, value);
+    writeOp(GL_TRACE_UNIFORM_MATRIX_4X3DV);
+    write32((uint32_t) location);
+    write32(count);
+    write32(transpose);
+    writePayload(value, count * 12 * sizeof(GLdouble));
+}
+
+static void GLAPIENTRY traceUniformBlockBinding(GLuint program, GLuint index, GLuint binding) {
+    realUniformBlockBinding(program, index, binding);
+    writeOp(GL_TRACE_UNIFORM_BLOCK_BINDING);
+    write32(program);
+    write32(index);
+    write32(binding);
+}
+
+static void GLAPIENTRY traceGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+    realGenFramebuffers(n, framebuffers);
+    writeNames(GL_TRACE_GEN_FRAMEBUFFERS, n, framebuffers);
+}
+
+static void GLAPIENTRY traceDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    realDeleteFramebuffers(n, framebuffers);
+    writeNames(GL_TRACE_DELETE_FRAMEBUFFERS, n, framebuffers);
+}
+
+static void GLAPIENTRY traceBindFramebuffer(GLenum target, GLuint framebuffer) {
+    realBindFramebuffer(target, framebuffer);
+    writeOp(GL_TRACE_BIND_FRAMEBUFFER);
+    write32(target);
+    write32(framebuffer);
+}
+
+static void GLAPIENTRY traceGenRenderbuffers(GLsizei n, GLuint* renderbuffers) {
+    realGenRenderbuffers(n, renderbuffers);
+    writeNames(GL_TRACE_GEN_RENDERBUFFERS, n, renderbuffers);
+}
+
+static void GLAPIENTRY traceDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
+    realDeleteRenderbuffers(n, renderbuffers);
+    writeNames(GL_TRACE_DELETE_RENDERBUFFERS, n, renderbuffers);
+}
+
+static void GLAPIENTRY traceBindRenderbuffer(GLenum target, GLuint renderbuffer) {
+    realBindRenderbuffer(target, renderbuffer);
+    writeOp(GL_TRACE_BIND_RENDERBUFFER);
+    write32(target);
+    write32(renderbuffer);
+}
+
+static void GLAPIENTRY traceRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+    realRenderbufferStorage(target, internalformat, width, height);
+    writeOp(GL_TRACE_RENDERBUFFER_STORAGE);
+    write32(target);
+    write32(internalformat);
+    write32(width);
+    write32(height);
+}
+
+static void GLAPIENTRY traceFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) {
+    realFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+    writeOp(GL_TRACE_FRAMEBUFFER_RENDERBUFFER);
+    write32(target);
+    write32(attachment);
+    write32(renderbuffertarget);
+    write32(renderbuffer);
+}
+
+static void GLAPIENTRY traceActiveTexture(GLenum texture) {
+    realActiveTexture(texture);
+    writeOp(GL_TRACE_ACTIVE_TEXTURE);
+    write32(texture);
+}
+
+static void GLAPIENTRY traceBindTexture(GLenum target, GLuint texture) {
+    realBindTexture(target, texture);
+    writeOp(GL_TRACE_BIND_TEXTURE);
+    write32(target);
+    write32(texture);
+}
+
+static void GLAPIENTRY traceClear(GLbitfield mask) {
+    realClear(mask);
+    writeOp(GL_TRACE_CLEAR);
+    write32(mask);
+}
+
+static void GLAPIENTRY traceClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    realClearColor(red, green, blue, alpha);
+    writeOp(GL_TRACE_CLEAR_COLOR);
+    writeFloat(red);
+    writeFloat(green);
+    writeFloat(blue);
+    writeFloat(alpha);
+}
+
+static void GLAPIENTRY traceViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    realViewport(x, y, width, height);
+    writeOp(GL_TRACE_VIEWPORT);
+    write32((uint32_t) x);
+    write32((uint32_t) y);
+    write32(width);
+    write32(height);
+}
+
+static void GLAPIENTRY traceEnable(GLenum cap) {
+    realEnable(cap);
+    writeOp(GL_TRACE_ENABLE);
+    write32(cap);
+}
+
+static void GLAPIENTRY traceDisable(GLenum cap) {
+    realDisable(cap);
+    writeOp(GL_TRACE_DISABLE);
+    write32(cap);
+}
+
+static void GLAPIENTRY tracePixelStorei(GLenum pname, GLint param) {
+    realPixelStorei(pname, param);
+    writeOp(GL_TRACE_PIXEL_STOREI);
+    write32(pname);
+    write32((uint32_t) param);
+}
+
+static void GLAPIENTRY traceDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    realDrawElements(mode, count, type, indices);
+    writeOp(GL_TRACE_DRAW_ELEMENTS);
+    write32(mode);
+    write32(count);
+    write32(type);
+    write64((uintptr_t) indices);
+}
+
+static void GLAPIENTRY traceDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount) {
+    realDrawElementsInstanced(mode, count, type, indices, instancecount);
+    writeOp(GL_TRACE_DRAW_ELEMENTS_INSTANCED);
+    write32(mode);
+    write32(count);
+    write32(type);
+    write64((uintptr_t) indices);
+    write32(instancecount);
+}
+
+static void GLAPIENTRY traceDrawElementsInstancedBaseInstance(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount, GLuint baseinstance) {
+    realDrawElementsInstancedBaseInstance(mode, count, type, indices, instancecount, baseinstance);
+    writeOp(GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_INSTANCE);
+    write32(mode);
+    write32(count);
+    write32(type);
+    write64((uintptr_t) indices);
+    write32(instancecount);
+    write32(baseinstance);
+}
+
+static void GLAPIENTRY traceDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, void* indices, GLint basevertex) {
+    realDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+    writeOp(GL_TRACE_DRAW_ELEMENTS_BASE_VERTEX);
+    write32(mode);
+    write32(count);
+    write32(type);
+    write64((uintptr_t) indices);
+    write32((uint32_t) basevertex);
+}
+
+static void GLAPIENTRY traceDrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount, GLint basevertex) {
+    realDrawElementsInstancedBaseVertex(mode, count, type, indices, instancecount, basevertex);
+    writeOp(GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX);
+    write32(mode);
+    write32(count);
+    write32(type);
+    write64((uintptr_t) indices);
+    write32(instancecount);
+    write32((uint32_t) basevertex);
+}
+
+static void GLAPIENTRY traceDrawElementsInstancedBaseVertexBaseInstance(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount,
+    GLint basevertex, GLuint baseinstance) {
+    realDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices, instancecount, basevertex, baseinstance);
+    writeOp(GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE);
+    write32(mode);
+    write32(count);
+    write32(type);
+    write64((uintptr_t) indices);
+    write32(instancecount);
+    write32((uint32_t) basevertex);
+    write32(baseinstance);
+}
+
+static void GLAPIENTRY traceMultiDrawElementsBaseVertex(GLenum mode, GLsizei* count, GLenum type, void** indices, GLsizei drawcount, GLint* basevertex) {
+    realMultiDrawElementsBaseVertex(mode, count, type, indices, drawcount, basevertex);
+    writeOp(GL_TRACE_MULTI_DRAW_ELEMENTS_BASE_VERTEX);
+    write32(mode);
+    write32(type);
+    write32(drawcount);
+    writePayload(count, drawcount * sizeof(GLsizei));
+    vector<uint64_t> offsets = vector<uint64_t>(drawcount);
+    for (GLsizei i = 0; i < drawcount; i++)
+        offsets[i] = (uintptr_t) indices[i];
+    writePayload(offsets.data(), offsets.size() * sizeof(uint64_t));
+    writePayload(basevertex, drawcount * sizeof(GLint));
+}
+
+static void GLAPIENTRY traceMultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride) {
+    realMultiDrawElementsIndirect(mode, type, indirect, drawcount, stride);
+    writeOp(GL_TRACE_MULTI_DRAW_ELEMENTS_INDIRECT);
+    write32(mode);
+    write32(type);
+    write64((uintptr_t) indirect);
+    write32(drawcount);
+    write32(stride);
+}
+
+static GLsync GLAPIENTRY traceFenceSync(GLenum condition, GLbitfield flags) {
+    GLsync sync = realFenceSync(condition, flags);
+    writeOp(GL_TRACE_FENCE_SYNC);
+    write32(condition);
+    write32(flags);
+    write64((uintptr_t) sync);
+    return sync;
+}
+
+static GLenum GLAPIENTRY traceClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+    GLenum result = realClientWaitSync(sync, flags, timeout);
+    writeOp(GL_TRACE_CLIENT_WAIT_SYNC);
+    write64((uintptr_t) sync);
+    write32(flags);
+    write64(timeout);
+    return result;
+}
+
+static void GLAPIENTRY traceDeleteSync(GLsync sync) {
+    realDeleteSync(sync);
+    writeOp(GL_TRACE_DELETE_SYNC);
+    write64((uintptr_t) sync);
+}
+
+static void GLAPIENTRY traceFlush() {
+    realFlush();
+    writeOp(GL_TRACE_FLUSH);
+}
+
+static void GLAPIENTRY traceFinish() {
+    realFinish();
+    writeOp(GL_TRACE_FINISH);
+}
+
+bool GLTrace::beginCapture(const string& filePath) {
+    ASSERT(!capturing);
+    traceFile.open(filePath, std::ios::binary);
+    if (!traceFile) {
+        cout << "Failed to open " << filePath << " for writing!" << endl;
+        return false;
+    }
+    traceData.reserve(FLUSH_SIZE + 1024);
+    write32(GL_TRACE_MAGIC);
+    write32(GL_TRACE_VERSION);
+
+#define INSTALL_HOOK(pointer, name) real##name = pointer; pointer = trace##name;
+    GL_TRACE_HOOKS(INSTALL_HOOK)
+#undef INSTALL_HOOK
+
+    capturing = true;
+    return true;
+}
+
+void GLTrace::endCapture() {
+    if (!capturing)
+        return;
+
+#define REMOVE_HOOK(pointer, name) pointer = real##name;
+    GL_TRACE_HOOKS(REMOVE_HOOK)
+#undef REMOVE_HOOK
+
+    flushTrace();
+    traceFile.close();
+    capturing = false;
+}
+
+void GLTrace::endFrame() {
+    if (capturing)
+        writeOp(GL_TRACE_FRAME);
+}
+
+void GLTrace::recordMappedWrite(unsigned int buffer, unsigned int offset, unsigned int size, const void* data) {
+    if (!capturing)
+        return;
+    writeOp(GL_TRACE_MAPPED_WRITE);
+    write32(buffer);
+    write64(offset);
+    writePayload(data, size);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+
+using std::string;
+
+/// <summary>
+/// Captures every OpenGL call we make (and what we write into mapped buffers) into a compact binary trace (see GLTraceFormat.h),
+/// frame by frame, so the GLReplay tool can re-run the exact same calls without any of our app code in the way.
+/// </summary>
+//NOTE: Works by swapping out GLEW's function pointers (and our own, see GLHooks.h) for ones that record each call and then make it,
+//      so nothing else has to know we're capturing. Only the calls that affect rendering are captured: queries, glGet* and error checks aren't.
+//      Writes into persistently mapped memory aren't GL calls, so whoever writes them has to tell us (see recordMappedWrite).
+class GLTrace {
+    private:
+    static bool capturing;
+
+    public:
+    /// <summary>
+    /// Starts capturing to filePath. Call right after initializing GLEW, before creating anything, since the replay needs every object we use.
+    /// </summary>
+    static bool beginCapture(const string& filePath);
+    static void endCapture();
+
+    inline static bool isCapturing() { return capturing; }
+
+    /// <summary>
+    /// Marks the end of a frame. The replayer runs the first frame (and everything before it) once as setup, then loops over the rest.
+    /// </summary>
+    static void endFrame();
+
+    /// <summary>
+    /// Records size bytes written into buffer's mapped memory, at offset from the start of the buffer.
+    /// Call once the writes are done, but before any draw that reads them.
+    /// </summary>
+    static void recordMappedWrite(unsigned int buffer, unsigned int offset, unsigned int size, const void* data);
+};
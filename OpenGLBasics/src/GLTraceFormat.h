@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+
+//A GL trace is a header (magic, then version), followed by one record per call: the opcode (1 byte), the size of its arguments in bytes (4 bytes), then its arguments.
+//NOTE: The size lets a reader skip over records without understanding them (e.g. to find the frames, or ops from a newer version).
+//Arguments are written in the order the OpenGL function takes them, in native byte order:
+//  GLenum, GLuint, GLint, GLsizei, GLbitfield, GLboolean:  4 bytes
+//  GLfloat:                                                4 bytes
+//  GLsizeiptr, GLintptr, GLuint64, offsets, GLsync:        8 bytes
+//  Arrays and data (payloads):                             4-byte size in bytes, then the bytes (size 0xFFFFFFFF for a null pointer)
+//Names OpenGL hands back to us (from glGen*, glCreate*, glGetUniformLocation, glFenceSync) come last, so the replayer can map them to its own.
+static const uint32_t GL_TRACE_MAGIC = 0x52544C47; //"GLTR"
+static const uint32_t GL_TRACE_VERSION = 3;
+
+static const uint32_t GL_TRACE_NULL_PAYLOAD = 0xFFFFFFFF;
+
+enum GLTraceOp : uint8_t {
+    //Marks the end of a frame. The first frame (and everything before it) is where everything gets created, so it's replayed as setup.
+    GL_TRACE_FRAME = 0,
+
+    //Buffers
+    GL_TRACE_GEN_BUFFERS,               //n, names[n]
+    GL_TRACE_DELETE_BUFFERS,            //n, names[n]
+    GL_TRACE_BIND_BUFFER,               //target, buffer
+    GL_TRACE_BIND_BUFFER_BASE,          //target, index, buffer
+    GL_TRACE_BUFFER_DATA,               //target, size, payload, usage
+    GL_TRACE_BUFFER_SUB_DATA,           //target, offset, payload
+    GL_TRACE_BUFFER_STORAGE,            //target, size, payload, flags
+    GL_TRACE_MAP_BUFFER_RANGE,          //target, offset, length, access
+    GL_TRACE_UNMAP_BUFFER,              //target
+    GL_TRACE_MAPPED_WRITE,              //buffer, offset (from the start of the buffer), payload. Not a GL call: what we wrote into mapped memory.
+
+    //Vertex arrays
+    GL_TRACE_GEN_VERTEX_ARRAYS,         //n, names[n]
+    GL_TRACE_DELETE_VERTEX_ARRAYS,      //n, names[n]
+    GL_TRACE_BIND_VERTEX_ARRAY,         //array
+    GL_TRACE_ENABLE_VERTEX_ATTRIB_ARRAY, //index
+    GL_TRACE_VERTEX_ATTRIB_POINTER,     //index, size, type, normalized, stride, offset
+    GL_TRACE_VERTEX_ATTRIB_DIVISOR,     //index, divisor
+
+    //Shaders
+    GL_TRACE_CREATE_SHADER,             //type, shader
+    GL_TRACE_SHADER_SOURCE,             //shader, count, payload[count]
+    GL_TRACE_COMPILE_SHADER,            //shader
+    GL_TRACE_DELETE_SHADER,             //shader
+    GL_TRACE_CREATE_PROGRAM,            //program
+    GL_TRACE_ATTACH_SHADER,             //program, shader
+    GL_TRACE_LINK_PROGRAM,              //program
+    GL_TRACE_VALIDATE_PROGRAM,          //program
+    GL_TRACE_DELETE_PROGRAM,            //program
+    GL_TRACE_USE_PROGRAM,               //program
+    GL_TRACE_GET_UNIFORM_LOCATION,      //program, payload (the name, with its null terminator), location
+    GL_TRACE_UNIFORM_1I,                //location, v0
+    GL_TRACE_UNIFORM_1F,                //location, v0
+    GL_TRACE_UNIFORM_4F,                //location, v0, v1, v2, v3
+    GL_TRACE_UNIFORM_1IV,               //location, count, payload
+    GL_TRACE_UNIFORM_4FV,               //location, count, payload
+    GL_TRACE_UNIFORM_MATRIX_4FV,        //location, count, transpose, payload
+    GL_TRACE_UNIFORM_1FV,               //location, count, payload
+    GL_TRACE_UNIFORM_2FV,               //location, count, payload
+    GL_TRACE_UNIFORM_3FV,               //location, count, payload
+    GL_TRACE_UNIFORM_2IV,               //location, count, payload
+    GL_TRACE_UNIFORM_3IV,               //location, count, payload
+    GL_TRACE_UNIFORM_4IV,               //location, count, payload
+    GL_TRACE_UNIFORM_1UIV,              //location, count, payload
+    GL_TRACE_UNIFORM_2UIV,              //location, count, payload
+    GL_TRACE_UNIFORM_3UIV,              //location, count, payload
+    GL_TRACE_UNIFORM_4UIV,              //location, count, payload
+    GL_TRACE_UNIFORM_MATRIX_2FV,        //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_3FV,        //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_2X3FV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_2X4FV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_3X2FV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_3X4FV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_4X2FV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_4X3FV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_1DV,               //location, count, payload
+    GL_TRACE_UNIFORM_2DV,               //location, count, payload
+    GL_TRACE_UNIFORM_3DV,               //location, count, payload
+    GL_TRACE_UNIFORM_4DV,               //location, count, payload
+    GL_TRACE_UNIFORM_MATRIX_2DV,        //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_3DV,        //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_4DV,        //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_2X3DV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_2X4DV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_3X2DV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_3X4DV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_4X2DV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_MATRIX_4X3DV,      //location, count, transpose, payload
+    GL_TRACE_UNIFORM_BLOCK_BINDING,     //program, index, binding
+
+    //Framebuffers
+    GL_TRACE_GEN_FRAMEBUFFERS,          //n, names[n]
+    GL_TRACE_DELETE_FRAMEBUFFERS,       //n, names[n]
+    GL_TRACE_BIND_FRAMEBUFFER,          //target, framebuffer
+    GL_TRACE_GEN_RENDERBUFFERS,         //n, names[n]
+    GL_TRACE_DELETE_RENDERBUFFERS,      //n, names[n]
+    GL_TRACE_BIND_RENDERBUFFER,         //target, renderbuffer
+    GL_TRACE_RENDERBUFFER_STORAGE,      //target, internalformat, width, height
+    GL_TRACE_FRAMEBUFFER_RENDERBUFFER,  //target, attachment, renderbuffertarget, renderbuffer
+
+    //Textures
+    GL_TRACE_ACTIVE_TEXTURE,            //texture (the unit)
+    GL_TRACE_BIND_TEXTURE,              //target, texture
+
+    //State
+    GL_TRACE_CLEAR,                     //mask
+    GL_TRACE_CLEAR_COLOR,               //red, green, blue, alpha
+    GL_TRACE_VIEWPORT,                  //x, y, width, height
+    GL_TRACE_ENABLE,                    //cap
+    GL_TRACE_DISABLE,                   //cap
+    GL_TRACE_PIXEL_STOREI,              //pname, param
+
+    //Draws (the indices are always an offset into the bound GL_ELEMENT_ARRAY_BUFFER)
+    GL_TRACE_DRAW_ELEMENTS,             //mode, count, type, offset
+    GL_TRACE_DRAW_ELEMENTS_INSTANCED,   //mode, count, type, offset, instancecount
+    GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_INSTANCE, //mode, count, type, offset, instancecount, baseinstance
+    GL_TRACE_DRAW_ELEMENTS_BASE_VERTEX, //mode, count, type, offset, basevertex
+    GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX, //mode, count, type, offset, instancecount, basevertex
+    GL_TRACE_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE, //mode, count, type, offset, instancecount, basevertex, baseinstance
+    GL_TRACE_MULTI_DRAW_ELEMENTS_BASE_VERTEX, //mode, type, drawcount, payload (counts), payload (offsets, 8 bytes each), payload (basevertices)
+    GL_TRACE_MULTI_DRAW_ELEMENTS_INDIRECT, //mode, type, offset, drawcount, stride
+
+    //Sync
+    GL_TRACE_FENCE_SYNC,                //condition, flags, sync
+    GL_TRACE_CLIENT_WAIT_SYNC,          //sync, flags, timeout
+    GL_TRACE_DELETE_SYNC,               //sync
+    GL_TRACE_FLUSH,
+    GL_TRACE_FINISH,
+
+    GL_TRACE_OP_COUNT
+};
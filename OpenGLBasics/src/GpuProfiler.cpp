@@ -0,0 +1,106 @@
+#include "OpenGLUtil.h"
+#include "GpuProfiler.h"
+
+GpuProfiler::Scope::Scope(const char* name)
+    : active(GpuProfiler::get().isEnabled()) {
+    if (active)
+        GpuProfiler::get().begin(name);
+}
+
+GpuProfiler::Scope::~Scope() {
+    if (active)
+        GpuProfiler::get().end();
+}
+
+GpuProfiler::Region::Region(const string& name)
+    : timer(MEASUREMENTS_IN_FLIGHT),
+    stats(),
+    lastFrame(UINT64_MAX) {
+    stats.name = name;
+}
+
+GpuProfiler& GpuProfiler::get() {
+    static GpuProfiler profiler;
+    return profiler;
+}
+
+GpuProfiler::GpuProfiler()
+    : enabled(false),
+    frame(0),
+    firstFrame(0) { }
+
+void GpuProfiler::setEnabled(bool enabled) {
+    //NOTE: Regions still open would never be closed.
+    ASSERT(openRegions.empty());
+    this->enabled = enabled;
+}
+
+void GpuProfiler::begin(const char* name) {
+    std::map<string, std::unique_ptr<Region>, std::less<>>::iterator it = regions.find(name);
+    if (it == regions.end())
+        it = regions.emplace(name, std::unique_ptr<Region>(new Region(name))).first;
+
+    Region* region = it->second.get();
+    region->timer.begin(frame);
+    openRegions.push_back(region);
+}
+
+void GpuProfiler::end() {
+    ASSERT(!openRegions.empty());
+    openRegions.back()->timer.end();
+    openRegions.pop_back();
+}
+
+void GpuProfiler::endFrame() {
+    for (std::pair<const string, std::unique_ptr<Region>>& entry : regions) {
+        entry.second->timer.collect(results);
+        store(*entry.second);
+    }
+    frame++;
+}
+
+void GpuProfiler::drain() {
+    for (std::pair<const string, std::unique_ptr<Region>>& entry : regions) {
+        entry.second->timer.drain(results);
+        store(*entry.second);
+    }
+}
+
+void GpuProfiler::reset() {
+    firstFrame = frame;
+    for (std::pair<const string, std::unique_ptr<Region>>& entry : regions) {
+        string name = entry.second->stats.name;
+        entry.second->stats = GpuRegionStats();
+        entry.second->stats.name = name;
+        entry.second->lastFrame = UINT64_MAX;
+    }
+}
+
+void GpuProfiler::release() {
+    ASSERT(openRegions.empty());
+    regions.clear();
+}
+
+vector<GpuRegionStats> GpuProfiler::getRegionStats() const {
+    vector<GpuRegionStats> list;
+    list.reserve(regions.size());
+    for (const std::pair<const string, std::unique_ptr<Region>>& entry : regions)
+        list.push_back(entry.second->stats);
+    return list;
+}
+
+void GpuProfiler::store(Region& region) {
+    for (const std::pair<uint64_t, double>& result : results) {
+        if (result.first < firstFrame)
+            continue;
+        region.stats.callCount++;
+        region.stats.totalMs += result.second;
+
+        //Results come back in order, so a new tag means a new frame.
+        if (result.first != region.lastFrame) {
+            region.stats.frameCount++;
+            region.lastFrame = result.first;
+        }
+    }
+    results.clear();
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GpuTimer.h"
+
+using std::string;
+using std::vector;
+
+struct GpuRegionStats {
+    string name;
+    unsigned int callCount;     //How many times the region was measured
+    unsigned int frameCount;    //How many frames it was measured in
+    double totalMs;
+
+    inline double getMsPerCall() const { return callCount == 0 ? 0 : totalMs / callCount; }
+    inline double getMsPerFrame() const { return frameCount == 0 ? 0 : totalMs / frameCount; }
+};
+
+/// <summary>
+/// Times named regions of GPU work (a flush, a render pass, ...) and keeps running averages for each, so you can see where the GPU's time goes.
+/// Each region gets its own GpuTimer, so results come back a few frames late and never stall the CPU.
+/// </summary>
+//NOTE: Usage:
+//      GpuProfiler::Scope scope("Shadows");
+//      ...draw...
+//Scopes do nothing while the profiler is disabled (the default), so the Renderer can time every flush without costing anything normally.
+//Regions can nest, but a region can't be open inside itself.
+class GpuProfiler {
+    public:
+    class Scope {
+        private:
+        bool active;
+
+        public:
+        //NOTE: Takes a string literal (or anything else that outlives the scope), so a disabled scope costs nothing but a bool check.
+        Scope(const char* name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    private:
+    //Per region, since a region can run several times per frame (e.g. every batch flush).
+    static const unsigned int MEASUREMENTS_IN_FLIGHT = 64;
+
+    struct Region {
+        GpuTimer timer;
+        GpuRegionStats stats;
+        uint64_t lastFrame; //The last frame a result came back for, to count frames
+
+        Region(const string& name);
+    };
+
+    bool enabled;
+    uint64_t frame;
+    uint64_t firstFrame; //Results from frames before this one are ignored (see reset())
+
+    //NOTE: std::map, so the regions come out sorted by name. std::less<> lets us look them up by const char* without making a string.
+    std::map<string, std::unique_ptr<Region>, std::less<>> regions;
+    vector<Region*> openRegions;
+    vector<std::pair<uint64_t, double>> results;
+
+    public:
+    static GpuProfiler& get();
+
+    GpuProfiler();
+
+    inline bool isEnabled() const { return enabled; }
+    void setEnabled(bool enabled);
+
+    void begin(const char* name);
+    void end();
+
+    /// <summary>
+    /// Collects whichever results are ready. Call once per frame, after the frame's work has been submitted.
+    /// </summary>
+    void endFrame();
+
+    /// <summary>
+    /// Waits for every result still in flight. Only use this when you're done rendering.
+    /// </summary>
+    void drain();
+
+    /// <summary>
+    /// Clears the averages, so they only cover frames from now on (e.g. after warming up).
+    /// </summary>
+    void reset();
+
+    /// <summary>
+    /// Deletes every region's queries. Call before the context goes away, since the profiler itself lives until the program exits.
+    /// </summary>
+    void release();
+
+    vector<GpuRegionStats> getRegionStats() const;
+
+    private:
+    void store(Region& region);
+};
@@ -0,0 +1,72 @@
+#include "OpenGLUtil.h"
+#include "GpuTimer.h"
+
+GpuTimer::GpuTimer(unsigned int capacity)
+    : capacity(capacity),
+    queries(capacity * 2),
+    tags(capacity),
+    first(0),
+    count(0),
+    running(false) {
+    GLCALL(glGenQueries(capacity * 2, queries.data()));
+}
+
+GpuTimer::~GpuTimer() {
+    GLCALL(glDeleteQueries(capacity * 2, queries.data()));
+}
+
+void GpuTimer::begin(uint64_t tag) {
+    ASSERT(!running);
+
+    //NOTE: Only happens when the GPU is more than capacity measurements behind, or nobody's collecting the results.
+    //      Either way, the oldest result is just dropped, so we never stall here.
+    if (count == capacity) {
+        first = (first + 1) % capacity;
+        count--;
+    }
+
+    unsigned int index = (first + count) % capacity;
+    tags[index] = tag;
+    GLCALL(glQueryCounter(queries[index * 2], GL_TIMESTAMP));
+    running = true;
+}
+
+void GpuTimer::end() {
+    ASSERT(running);
+    unsigned int index = (first + count) % capacity;
+    GLCALL(glQueryCounter(queries[index * 2 + 1], GL_TIMESTAMP));
+    count++;
+    running = false;
+}
+
+void GpuTimer::collect(vector<pair<uint64_t, double>>& results) {
+    while (count > 0 && isReady(first)) {
+        results.push_back(pair<uint64_t, double>(tags[first], read(first)));
+        first = (first + 1) % capacity;
+        count--;
+    }
+}
+
+void GpuTimer::drain(vector<pair<uint64_t, double>>& results) {
+    //NOTE: Reading GL_QUERY_RESULT waits for the result, which is exactly what we want here.
+    while (count > 0) {
+        results.push_back(pair<uint64_t, double>(tags[first], read(first)));
+        first = (first + 1) % capacity;
+        count--;
+    }
+}
+
+bool GpuTimer::isReady(unsigned int index) const {
+    //The end query finishes after the begin query, so it's the only one we need to check.
+    GLuint available = GL_FALSE;
+    GLCALL(glGetQueryObjectuiv(queries[index * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available));
+    return available == GL_TRUE;
+}
+
+double GpuTimer::read(unsigned int index) const {
+    GLuint64 start;
+    GLuint64 end;
+    GLCALL(glGetQueryObjectui64v(queries[index * 2], GL_QUERY_RESULT, &start));
+    GLCALL(glGetQueryObjectui64v(queries[index * 2 + 1], GL_QUERY_RESULT, &end));
+    return (end - start) / 1000000.0; //Nanoseconds to milliseconds
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using std::pair;
+using std::vector;
+
+/// <summary>
+/// Measures how long the GPU takes for the work between begin() and end(), without ever stalling the CPU to find out.
+/// Each measurement uses a pair of GL_TIMESTAMP queries from a ring, and we only read them back once they're ready (a few frames later).
+/// </summary>
+//NOTE: Timestamps (unlike GL_TIME_ELAPSED queries) can be nested, so timers can overlap each other freely.
+class GpuTimer {
+    private:
+    //How many measurements can be in flight at once. Reading back any sooner would stall on the GPU.
+    unsigned int capacity;
+    vector<unsigned int> queries; //Begin and end query for each measurement, interleaved
+    vector<uint64_t> tags;
+    unsigned int first; //Oldest measurement we haven't read back yet
+    unsigned int count; //How many measurements we haven't read back yet
+    bool running;
+
+    public:
+    /// <param name="capacity">How many measurements can be waiting to be read back at once. About 5 per measurement per frame is plenty.</param>
+    GpuTimer(unsigned int capacity = 5);
+    ~GpuTimer();
+
+    //NOTE: Owns query objects, so no copies.
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /// <param name="tag">Comes back with the result, so you can tell which measurement it was (e.g. the frame number).</param>
+    void begin(uint64_t tag);
+    void end();
+
+    /// <summary>
+    /// Adds every finished measurement to results as (tag, milliseconds), oldest first, without waiting on the GPU.
+    /// </summary>
+    void collect(vector<pair<uint64_t, double>>& results);
+
+    /// <summary>
+    /// Like collect(), but waits for every measurement still in flight. Only use this when you're done rendering.
+    /// </summary>
+    void drain(vector<pair<uint64_t, double>>& results);
+
+    private:
+    bool isReady(unsigned int index) const;
+    double read(unsigned int index) const;
+};
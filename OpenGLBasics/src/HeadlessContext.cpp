@@ -0,0 +1,144 @@
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "OpenGLUtil.h"
+
+#include <GLFW/glfw3.h>
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include "HeadlessContext.h"
+
+using std::cout;
+using std::endl;
+
+HeadlessContext::HeadlessContext(bool noError)
+    : eglDisplay(nullptr),
+    eglContext(nullptr),
+    hiddenWindow(nullptr) {
+    if (!createEGLContext(noError))
+        createHiddenWindow(noError);
+}
+
+HeadlessContext::~HeadlessContext() {
+#ifdef __linux__
+    if (eglContext != nullptr) {
+        eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(eglDisplay, eglContext);
+        eglTerminate(eglDisplay);
+    }
+#endif
+    if (hiddenWindow != nullptr) {
+        glfwDestroyWindow(hiddenWindow);
+        glfwTerminate();
+    }
+}
+
+const char* HeadlessContext::getBackendName() const {
+    if (eglContext != nullptr)
+        return "EGL (surfaceless)";
+    if (hiddenWindow != nullptr)
+        return "GLFW (hidden window)";
+    return "none";
+}
+
+bool HeadlessContext::createEGLContext(bool noError) {
+#ifdef __linux__
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (clientExtensions == nullptr || strstr(clientExtensions, "EGL_MESA_platform_surfaceless") == nullptr) {
+        cout << "EGL_MESA_platform_surfaceless isn't available." << endl;
+        return false;
+    }
+
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay == nullptr)
+        return false;
+
+    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        cout << "Failed to initialize the surfaceless EGL display!" << endl;
+        return false;
+    }
+
+    //NOTE: Surfaceless displays don't have window configs, and EGL_SURFACE_TYPE defaults to EGL_WINDOW_BIT, so ask for pbuffer configs.
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        cout << "No suitable EGL config for desktop OpenGL!" << endl;
+        eglTerminate(display);
+        return false;
+    }
+
+    //OpenGL 3.3, Core context, same as our windowed mode
+    std::vector<EGLint> contextAttributes = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT
+    };
+
+    //NOTE: A context can't be both. The no-error attribute needs EGL_KHR_create_context_no_error, which we check for on the display.
+    const char* displayExtensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (noError && displayExtensions != nullptr && strstr(displayExtensions, "EGL_KHR_create_context_no_error") != nullptr) {
+        contextAttributes.push_back(EGL_CONTEXT_OPENGL_NO_ERROR_KHR);
+        contextAttributes.push_back(EGL_TRUE);
+    } else if (noError) {
+        cout << "EGL_KHR_create_context_no_error isn't available, so the context will still check for errors." << endl;
+    } else if (glWantsDebugContext()) {
+        contextAttributes.push_back(EGL_CONTEXT_OPENGL_DEBUG);
+        contextAttributes.push_back(EGL_TRUE);
+    }
+    contextAttributes.push_back(EGL_NONE);
+
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes.data());
+    if (context == EGL_NO_CONTEXT) {
+        cout << "Failed to create an EGL context!" << endl;
+        eglTerminate(display);
+        return false;
+    }
+
+    //NOTE: Needs EGL_KHR_surfaceless_context, which every surfaceless display has.
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        cout << "Failed to make the EGL context current!" << endl;
+        eglDestroyContext(display, context);
+        eglTerminate(display);
+        return false;
+    }
+
+    eglDisplay = display;
+    eglContext = context;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool HeadlessContext::createHiddenWindow(bool noError) {
+    if (!glfwInit())
+        return false;
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_NO_ERROR, noError ? GLFW_TRUE : GLFW_FALSE);
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, !noError && glWantsDebugContext() ? GLFW_TRUE : GLFW_FALSE);
+
+    //NOTE: We never draw to its default framebuffer, so its size doesn't matter.
+    hiddenWindow = glfwCreateWindow(1, 1, "Headless", NULL, NULL);
+    if (hiddenWindow == NULL) {
+        glfwTerminate();
+        return false;
+    }
+    glfwMakeContextCurrent(hiddenWindow);
+    return true;
+}
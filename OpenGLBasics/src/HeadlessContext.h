@@ -0,0 +1,28 @@
+#pragma once
+
+struct GLFWwindow;
+
+/// <summary>
+/// An OpenGL 3.3 core context that doesn't need a window (or even a display), so we can render on GPU-less build agents.
+/// Render into a <see cref="Framebuffer"/>, since there's no default framebuffer to draw to.
+/// </summary>
+//NOTE: On Linux, we use EGL's surfaceless platform (EGL_MESA_platform_surfaceless), which works on Mesa's llvmpipe with no X server.
+//      Everywhere else (or if that fails), we fall back to a hidden GLFW window, which does still need a display.
+class HeadlessContext {
+    private:
+    void* eglDisplay;
+    void* eglContext;
+    GLFWwindow* hiddenWindow;
+
+    public:
+    /// <param name="noError">Ask for a KHR_no_error context, where OpenGL skips its error checking (so any error is undefined behavior). Otherwise, we ask for a debug context when GLCALL wants one.</param>
+    HeadlessContext(bool noError = false);
+    ~HeadlessContext();
+
+    inline bool isValid() const { return eglContext != nullptr || hiddenWindow != nullptr; }
+    const char* getBackendName() const;
+
+    private:
+    bool createEGLContext(bool noError);
+    bool createHiddenWindow(bool noError);
+};
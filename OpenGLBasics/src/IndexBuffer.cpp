@@ -1,4 +1,7 @@
 #include "OpenGLUtil.h"
+#include "GLStateCache.h"
+#include "RedrawTracker.h"
+#include "RenderStats.h"
 #include "IndexBuffer.h"
 
 IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count) {
@@ -6,19 +9,24 @@ IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count) {
     this->count = count;
 
     GLCALL(glGenBuffers(1, &rendererId));
+    RenderStats::get().onBufferCreated();
     bind();
     GLCALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));
+    RenderStats::get().onBufferUpload(count * sizeof(unsigned int));
+    RedrawTracker::get().invalidate();
 }
 
 IndexBuffer::~IndexBuffer() {
     GLCALL(glDeleteBuffers(1, &rendererId));
+    GLStateCache::get().onBufferDeleted(rendererId);
+    RenderStats::get().onBufferDeleted();
 }
 
 void IndexBuffer::bind() const {
-    GLCALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererId));
+    GLStateCache::get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererId);
 }
 
 void IndexBuffer::unbind() const {
     //TODO: Use or not use NULL from vcruntime.h?
-    GLCALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    GLStateCache::get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
@@ -0,0 +1,89 @@
+#include <cstdint>
+
+#include "OpenGLUtil.h"
+#include "GLStateCache.h"
+#include "RedrawTracker.h"
+#include "RenderStats.h"
+#include "IndirectBuffer.h"
+
+IndirectBuffer::IndirectBuffer()
+    : rendererId(0),
+    capacity(0),
+    instanced(false),
+    uploadedCount(0),
+    uploadedTriangles(0) {
+    if (isSupported()) {
+        GLCALL(glGenBuffers(1, &rendererId));
+        RenderStats::get().onBufferCreated();
+    }
+}
+
+IndirectBuffer::~IndirectBuffer() {
+    if (rendererId != 0) {
+        GLCALL(glDeleteBuffers(1, &rendererId));
+        GLStateCache::get().onBufferDeleted(rendererId);
+        RenderStats::get().onBufferDeleted();
+    }
+}
+
+bool IndirectBuffer::isSupported() {
+    return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+}
+
+void IndirectBuffer::push(unsigned int indexCount, unsigned int firstIndex, int baseVertex, unsigned int instanceCount, unsigned int baseInstance) {
+    DrawElementsIndirectCommand command = {
+        indexCount,
+        instanceCount,
+        firstIndex,
+        baseVertex,
+        baseInstance
+    };
+    commands.push_back(command);
+}
+
+void IndirectBuffer::clear() {
+    commands.clear();
+}
+
+void IndirectBuffer::upload() {
+    instanced = false;
+    uploadedTriangles = 0;
+    for (const DrawElementsIndirectCommand& command : commands) {
+        if (command.instanceCount != 1 || command.baseInstance != 0)
+            instanced = true;
+        uploadedTriangles += (uint64_t) (command.count / 3) * command.instanceCount;
+    }
+    uploadedCount = (unsigned int) commands.size();
+
+    if (rendererId == 0) {
+        fallbackCommands = commands;
+        counts.resize(commands.size());
+        offsets.resize(commands.size());
+        baseVertices.resize(commands.size());
+        for (size_t i = 0; i < commands.size(); i++) {
+            counts[i] = commands[i].count;
+            offsets[i] = (const void*) (uintptr_t) (commands[i].firstIndex * sizeof(unsigned int));
+            baseVertices[i] = commands[i].baseVertex;
+        }
+        return;
+    }
+
+    unsigned int size = (unsigned int) (commands.size() * sizeof(DrawElementsIndirectCommand));
+    bind();
+    if (commands.size() > capacity) {
+        GLCALL(glBufferData(GL_DRAW_INDIRECT_BUFFER, size, commands.data(), GL_DYNAMIC_DRAW));
+        capacity = (unsigned int) commands.size();
+    } else {
+        GLCALL(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, commands.data()));
+    }
+    RenderStats::get().onBufferUpload(size);
+    RedrawTracker::get().invalidate();
+}
+
+void IndirectBuffer::bind() const {
+    GLStateCache::get().bindBuffer(GL_DRAW_INDIRECT_BUFFER, rendererId);
+}
+
+void IndirectBuffer::unbind() const {
+    GLStateCache::get().bindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
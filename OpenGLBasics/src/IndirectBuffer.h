@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+/// <summary>
+/// Matches the layout OpenGL expects in a GL_DRAW_INDIRECT_BUFFER for glMultiDrawElementsIndirect.
+/// </summary>
+struct DrawElementsIndirectCommand {
+    unsigned int count;         //Number of indices
+    unsigned int instanceCount;
+    unsigned int firstIndex;    //NOTE: In indices, NOT bytes.
+    int baseVertex;
+    unsigned int baseInstance;
+};
+
+/// <summary>
+/// A bucket of draws that all share one VAO, index buffer and shader, stored on the GPU so
+/// <see cref="Renderer::drawIndirect"/> can issue the whole bucket with one call.
+/// </summary>
+//NOTE: We keep a CPU copy of the commands, so we can still draw them with glMultiDrawElementsBaseVertex
+//      (OpenGL 3.2) when glMultiDrawElementsIndirect (OpenGL 4.3 / ARB_multi_draw_indirect) isn't available.
+//      Drawing always uses what the last upload() sent, not whatever's been pushed since.
+class IndirectBuffer {
+    private:
+    unsigned int rendererId; //NOTE: 0 when we're using the fallback path.
+    unsigned int capacity;   //In commands, of the GPU buffer
+    vector<DrawElementsIndirectCommand> commands;
+    bool instanced; //NOTE: True when any command draws more than 1 instance, or from a base instance.
+
+    //What the last upload() sent, which is what gets drawn
+    unsigned int uploadedCount;
+    uint64_t uploadedTriangles;
+
+    //Fallback path arguments, prepared by upload() so drawing doesn't need to allocate.
+    vector<DrawElementsIndirectCommand> fallbackCommands;
+    vector<int> counts;
+    vector<const void*> offsets;
+    vector<int> baseVertices;
+
+    public:
+    IndirectBuffer();
+    ~IndirectBuffer();
+
+    static bool isSupported();
+
+    /// <summary>
+    /// Adds one mesh's draw to the bucket. Nothing is sent to the GPU until <see cref="upload"/>.
+    /// </summary>
+    void push(unsigned int indexCount, unsigned int firstIndex, int baseVertex, unsigned int instanceCount = 1, unsigned int baseInstance = 0);
+    void clear();
+    void upload();
+
+    //NOTE: Includes commands pushed since the last upload(), which won't be drawn until the next one.
+    inline unsigned int getCount() const { return (unsigned int) commands.size(); }
+    inline unsigned int getUploadedCount() const { return uploadedCount; }
+    inline uint64_t getUploadedTriangleCount() const { return uploadedTriangles; }
+    inline const vector<DrawElementsIndirectCommand>& getCommands() const { return commands; }
+    inline bool usesFallback() const { return rendererId == 0; }
+    inline bool isInstanced() const { return instanced; }
+
+    inline const vector<DrawElementsIndirectCommand>& getFallbackCommands() const { return fallbackCommands; }
+    inline const vector<int>& getFallbackCounts() const { return counts; }
+    inline const vector<const void*>& getFallbackOffsets() const { return offsets; }
+    inline const vector<int>& getFallbackBaseVertices() const { return baseVertices; }
+
+    void bind() const;
+    void unbind() const;
+};
@@ -0,0 +1,502 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OpenGLUtil.h"
+#include "NullGL.h"
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+bool NullGL::installed = false;
+
+//Every function we replace: the pointer we swap out, and its name.
+//STUB functions just count the call and return 0 (or nothing), while the FAKE ones need to act a bit more like the real thing (see null##name).
+#define NULL_GL_FUNCTIONS(STUB, FAKE) \
+    FAKE(__glewGenBuffers, GenBuffers) \
+    FAKE(__glewDeleteBuffers, DeleteBuffers) \
+    FAKE(__glewBindBuffer, BindBuffer) \
+    FAKE(__glewBindBufferBase, BindBufferBase) \
+    FAKE(__glewBufferData, BufferData) \
+    STUB(__glewBufferSubData, BufferSubData) \
+    FAKE(__glewBufferStorage, BufferStorage) \
+    FAKE(__glewMapBufferRange, MapBufferRange) \
+    FAKE(__glewUnmapBuffer, UnmapBuffer) \
+    FAKE(__glewGenVertexArrays, GenVertexArrays) \
+    STUB(__glewDeleteVertexArrays, DeleteVertexArrays) \
+    STUB(__glewBindVertexArray, BindVertexArray) \
+    STUB(__glewEnableVertexAttribArray, EnableVertexAttribArray) \
+    STUB(__glewVertexAttribPointer, VertexAttribPointer) \
+    STUB(__glewVertexAttribDivisor, VertexAttribDivisor) \
+    FAKE(__glewCreateShader, CreateShader) \
+    FAKE(__glewShaderSource, ShaderSource) \
+    STUB(__glewCompileShader, CompileShader) \
+    FAKE(__glewGetShaderiv, GetShaderiv) \
+    STUB(__glewGetShaderInfoLog, GetShaderInfoLog) \
+    FAKE(__glewDeleteShader, DeleteShader) \
+    FAKE(__glewCreateProgram, CreateProgram) \
+    FAKE(__glewAttachShader, AttachShader) \
+    FAKE(__glewLinkProgram, LinkProgram) \
+    STUB(__glewValidateProgram, ValidateProgram) \
+    FAKE(__glewGetProgramiv, GetProgramiv) \
+    STUB(__glewGetProgramInfoLog, GetProgramInfoLog) \
+    FAKE(__glewDeleteProgram, DeleteProgram) \
+    STUB(__glewProgramParameteri, ProgramParameteri) \
+    STUB(__glewProgramBinary, ProgramBinary) \
+    STUB(__glewGetProgramBinary, GetProgramBinary) \
+    STUB(__glewUseProgram, UseProgram) \
+    FAKE(__glewGetUniformLocation, GetUniformLocation) \
+    STUB(__glewUniform1i, Uniform1i) \
+    STUB(__glewUniform1f, Uniform1f) \
+    STUB(__glewUniform4f, Uniform4f) \
+    STUB(__glewUniform1iv, Uniform1iv) \
+    STUB(__glewUniform4fv, Uniform4fv) \
+    STUB(__glewUniformMatrix4fv, UniformMatrix4fv) \
+    STUB(__glewUniform1fv, Uniform1fv) \
+    STUB(__glewUniform2fv, Uniform2fv) \
+    STUB(__glewUniform3fv, Uniform3fv) \
+    STUB(__glewUniform2iv, Uniform2iv) \
+    STUB(__glewUniform3iv, Uniform3iv) \
+    STUB(__glewUniform4iv, Uniform4iv) \
+    STUB(__glewUniform1uiv, Uniform1uiv) \
+    STUB(__glewUniform2uiv, Uniform2uiv) \
+    STUB(__glewUniform3uiv, Uniform3uiv) \
+    STUB(__glewUniform4uiv, Uniform4uiv) \
+    STUB(__glewUniformMatrix2fv, UniformMatrix2fv) \
+    STUB(__glewUniformMatrix3fv, UniformMatrix3fv) \
+    STUB(__glewUniformMatrix2x3fv, UniformMatrix2x3fv) \
+    STUB(__glewUniformMatrix2x4fv, UniformMatrix2x4fv) \
+    STUB(__glewUniformMatrix3x2fv, UniformMatrix3x2fv) \
+    STUB(__glewUniformMatrix3x4fv, UniformMatrix3x4fv) \
+    STUB(__glewUniformMatrix4x2fv, UniformMatrix4x2fv) \
+    STUB(__glewUniformMatrix4x3fv, UniformMatrix4x3fv) \
+    STUB(__glewUniform1dv, Uniform1dv) \
+    STUB(__glewUniform2dv, Uniform2dv) \
+    STUB(__glewUniform3dv, Uniform3dv) \
+    STUB(__glewUniform4dv, Uniform4dv) \
+    STUB(__glewUniformMatrix2dv, UniformMatrix2dv) \
+    STUB(__glewUniformMatrix3dv, UniformMatrix3dv) \
+    STUB(__glewUniformMatrix4dv, UniformMatrix4dv) \
+    STUB(__glewUniformMatrix2x3dv, UniformMatrix2x3dv) \
+    STUB(__glewUniformMatrix2x4dv, UniformMatrix2x4dv) \
+    STUB(__glewUniformMatrix3x2dv, UniformMatrix3x2dv) \
+    STUB(__glewUniformMatrix3x4dv, UniformMatrix3x4dv) \
+    STUB(__glewUniformMatrix4x2dv, UniformMatrix4x2dv) \
+    STUB(__glewUniformMatrix4x3dv, UniformMatrix4x3dv) \
+    FAKE(__glewGetActiveUniform, GetActiveUniform) \
+    STUB(__glewGetActiveUniformBlockName, GetActiveUniformBlockName) \
+    STUB(__glewUniformBlockBinding, UniformBlockBinding) \
+    FAKE(__glewGenFramebuffers, GenFramebuffers) \
+    STUB(__glewDeleteFramebuffers, DeleteFramebuffers) \
+    STUB(__glewBindFramebuffer, BindFramebuffer) \
+    FAKE(__glewCheckFramebufferStatus, CheckFramebufferStatus) \
+    FAKE(__glewGenRenderbuffers, GenRenderbuffers) \
+    STUB(__glewDeleteRenderbuffers, DeleteRenderbuffers) \
+    STUB(__glewBindRenderbuffer, BindRenderbuffer) \
+    STUB(__glewRenderbufferStorage, RenderbufferStorage) \
+    STUB(__glewFramebufferRenderbuffer, FramebufferRenderbuffer) \
+    STUB(__glewActiveTexture, ActiveTexture) \
+    STUB(glhBindTexture, BindTexture) \
+    STUB(glhClear, Clear) \
+    STUB(glhClearColor, ClearColor) \
+    STUB(glhViewport, Viewport) \
+    STUB(glhEnable, Enable) \
+    STUB(glhDisable, Disable) \
+    STUB(glhPixelStorei, PixelStorei) \
+    STUB(glhReadPixels, ReadPixels) \
+    STUB(glhDrawElements, DrawElements) \
+    STUB(__glewDrawElementsInstanced, DrawElementsInstanced) \
+    STUB(__glewDrawElementsInstancedBaseInstance, DrawElementsInstancedBaseInstance) \
+    STUB(__glewDrawElementsBaseVertex, DrawElementsBaseVertex) \
+    STUB(__glewDrawElementsInstancedBaseVertex, DrawElementsInstancedBaseVertex) \
+    STUB(__glewDrawElementsInstancedBaseVertexBaseInstance, DrawElementsInstancedBaseVertexBaseInstance) \
+    STUB(__glewMultiDrawElementsBaseVertex, MultiDrawElementsBaseVertex) \
+    STUB(__glewMultiDrawElementsIndirect, MultiDrawElementsIndirect) \
+    FAKE(__glewFenceSync, FenceSync) \
+    FAKE(__glewClientWaitSync, ClientWaitSync) \
+    STUB(__glewDeleteSync, DeleteSync) \
+    FAKE(__glewGenQueries, GenQueries) \
+    STUB(__glewDeleteQueries, DeleteQueries) \
+    STUB(__glewQueryCounter, QueryCounter) \
+    FAKE(__glewGetQueryObjectuiv, GetQueryObjectuiv) \
+    FAKE(__glewGetQueryObjectui64v, GetQueryObjectui64v) \
+    STUB(__glewDebugMessageCallback, DebugMessageCallback) \
+    STUB(__glewDebugMessageControl, DebugMessageControl) \
+    STUB(glhFlush, Flush) \
+    STUB(glhFinish, Finish) \
+    STUB(glhGetError, GetError) \
+    FAKE(glhGetIntegerv, GetIntegerv) \
+    FAKE(glhGetString, GetString)
+
+#define DECLARE_FUNCTION(pointer, name) NULL_GL_##name,
+enum NullGLFunction {
+    NULL_GL_FUNCTIONS(DECLARE_FUNCTION, DECLARE_FUNCTION)
+    NULL_GL_FUNCTION_COUNT
+};
+#undef DECLARE_FUNCTION
+
+#define FUNCTION_NAME(pointer, name) "gl" #name,
+static const char* const FUNCTION_NAMES[NULL_GL_FUNCTION_COUNT] = {
+    NULL_GL_FUNCTIONS(FUNCTION_NAME, FUNCTION_NAME)
+};
+#undef FUNCTION_NAME
+
+static uint64_t callCounts[NULL_GL_FUNCTION_COUNT];
+
+//NOTE: One name counter for every kind of object. The real thing keeps them separate, but nothing we do cares.
+static GLuint nextName = 1;
+
+static unordered_map<GLenum, GLuint> boundBuffers;      //target => buffer
+static unordered_map<GLuint, vector<char>> bufferData;  //buffer => its "GPU" memory, so there's something to map
+
+//A uniform "linked" into a program, so Shader has a uniform table to reflect (and its setUniform calls get as far as they would with a driver)
+struct NullUniform {
+    string name;
+    GLenum type;
+    GLint size;
+    GLint location;
+};
+
+static unordered_map<GLuint, string> shaderSources;             //shader => its source
+static unordered_map<GLuint, vector<GLuint>> programShaders;    //program => its attached shaders
+static unordered_map<GLuint, vector<NullUniform>> programUniforms;
+
+//Does nothing but count the call, for any function pointer type.
+template <NullGLFunction function, typename Pointer>
+struct NullStub;
+
+template <NullGLFunction function, typename Result, typename... Args>
+struct NullStub<function, Result (GLAPIENTRY*)(Args...)> {
+    static Result GLAPIENTRY call(Args...) {
+        callCounts[function]++;
+        return Result();
+    }
+};
+
+static void genNames(GLsizei count, GLuint* names) {
+    for (GLsizei i = 0; i < count; i++)
+        names[i] = nextName++;
+}
+
+static void GLAPIENTRY nullGenBuffers(GLsizei count, GLuint* buffers) {
+    callCounts[NULL_GL_GenBuffers]++;
+    genNames(count, buffers);
+}
+
+static void GLAPIENTRY nullDeleteBuffers(GLsizei count, const GLuint* buffers) {
+    callCounts[NULL_GL_DeleteBuffers]++;
+    for (GLsizei i = 0; i < count; i++)
+        bufferData.erase(buffers[i]);
+}
+
+static void GLAPIENTRY nullBindBuffer(GLenum target, GLuint buffer) {
+    callCounts[NULL_GL_BindBuffer]++;
+    boundBuffers[target] = buffer;
+}
+
+static void GLAPIENTRY nullBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    callCounts[NULL_GL_BindBufferBase]++;
+    boundBuffers[target] = buffer;
+}
+
+//NOTE: We don't bother copying any data in. Nothing will ever read it back, except through a mapping, which only ever gets written.
+static void GLAPIENTRY nullBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    callCounts[NULL_GL_BufferData]++;
+    bufferData[boundBuffers[target]].resize((size_t) size);
+}
+
+static void GLAPIENTRY nullBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+    callCounts[NULL_GL_BufferStorage]++;
+    bufferData[boundBuffers[target]].resize((size_t) size);
+}
+
+static void* GLAPIENTRY nullMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    callCounts[NULL_GL_MapBufferRange]++;
+    vector<char>& data = bufferData[boundBuffers[target]];
+    if ((size_t) (offset + length) > data.size())
+        return nullptr;
+    return data.data() + offset;
+}
+
+static GLboolean GLAPIENTRY nullUnmapBuffer(GLenum target) {
+    callCounts[NULL_GL_UnmapBuffer]++;
+    return GL_TRUE;
+}
+
+static void GLAPIENTRY nullGenVertexArrays(GLsizei count, GLuint* arrays) {
+    callCounts[NULL_GL_GenVertexArrays]++;
+    genNames(count, arrays);
+}
+
+static GLuint GLAPIENTRY nullCreateShader(GLenum type) {
+    callCounts[NULL_GL_CreateShader]++;
+    return nextName++;
+}
+
+//Every shader compiles, and every program links, without a word.
+static void GLAPIENTRY nullGetShaderiv(GLuint shader, GLenum name, GLint* value) {
+    callCounts[NULL_GL_GetShaderiv]++;
+    *value = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+static void GLAPIENTRY nullShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths) {
+    callCounts[NULL_GL_ShaderSource]++;
+    string& source = shaderSources[shader];
+    source.clear();
+    for (GLsizei i = 0; i < count; i++) {
+        if (lengths != nullptr && lengths[i] >= 0)
+            source.append(strings[i], lengths[i]);
+        else
+            source.append(strings[i]);
+    }
+}
+
+static void GLAPIENTRY nullDeleteShader(GLuint shader) {
+    callCounts[NULL_GL_DeleteShader]++;
+    shaderSources.erase(shader);
+}
+
+static GLuint GLAPIENTRY nullCreateProgram() {
+    callCounts[NULL_GL_CreateProgram]++;
+    return nextName++;
+}
+
+static void GLAPIENTRY nullAttachShader(GLuint program, GLuint shader) {
+    callCounts[NULL_GL_AttachShader]++;
+    programShaders[program].push_back(shader);
+}
+
+static GLenum getUniformType(const string& name) {
+    static const std::pair<const char*, GLenum> TYPES[] = {
+        { "float", GL_FLOAT }, { "vec2", GL_FLOAT_VEC2 }, { "vec3", GL_FLOAT_VEC3 }, { "vec4", GL_FLOAT_VEC4 },
+        { "int", GL_INT }, { "ivec2", GL_INT_VEC2 }, { "ivec3", GL_INT_VEC3 }, { "ivec4", GL_INT_VEC4 },
+        { "uint", GL_UNSIGNED_INT }, { "uvec2", GL_UNSIGNED_INT_VEC2 }, { "uvec3", GL_UNSIGNED_INT_VEC3 }, { "uvec4", GL_UNSIGNED_INT_VEC4 },
+        { "bool", GL_BOOL }, { "mat2", GL_FLOAT_MAT2 }, { "mat3", GL_FLOAT_MAT3 }, { "mat4", GL_FLOAT_MAT4 },
+        { "mat2x3", GL_FLOAT_MAT2x3 }, { "mat2x4", GL_FLOAT_MAT2x4 }, { "mat3x2", GL_FLOAT_MAT3x2 },
+        { "mat3x4", GL_FLOAT_MAT3x4 }, { "mat4x2", GL_FLOAT_MAT4x2 }, { "mat4x3", GL_FLOAT_MAT4x3 },
+        { "double", GL_DOUBLE }, { "dvec2", GL_DOUBLE_VEC2 }, { "dvec3", GL_DOUBLE_VEC3 }, { "dvec4", GL_DOUBLE_VEC4 },
+        { "dmat2", GL_DOUBLE_MAT2 }, { "dmat3", GL_DOUBLE_MAT3 }, { "dmat4", GL_DOUBLE_MAT4 },
+        { "dmat2x3", GL_DOUBLE_MAT2x3 }, { "dmat2x4", GL_DOUBLE_MAT2x4 }, { "dmat3x2", GL_DOUBLE_MAT3x2 },
+        { "dmat3x4", GL_DOUBLE_MAT3x4 }, { "dmat4x2", GL_DOUBLE_MAT4x2 }, { "dmat4x3", GL_DOUBLE_MAT4x3 },
+        { "sampler2D", GL_SAMPLER_2D }, { "sampler3D", GL_SAMPLER_3D }, { "samplerCube", GL_SAMPLER_CUBE }
+    };
+    for (const std::pair<const char*, GLenum>& type : TYPES) {
+        if (name == type.first)
+            return type.second;
+    }
+    return GL_NONE;
+}
+
+//"Links" the program, by finding the plain uniform declarations ("uniform vec4 u_Color;", "uniform int u_Textures[8];") in its shaders.
+//NOTE: Not a GLSL parser. Blocks, structs and anything the preprocessor would leave out are either skipped or counted anyway,
+//      but that's fine for keeping the renderer's uniform path busy.
+static void GLAPIENTRY nullLinkProgram(GLuint program) {
+    callCounts[NULL_GL_LinkProgram]++;
+    vector<NullUniform>& uniforms = programUniforms[program];
+    uniforms.clear();
+    GLint nextLocation = 0;
+    for (GLuint shader : programShaders[program]) {
+        std::istringstream lines = std::istringstream(shaderSources[shader]);
+        string line;
+        while (std::getline(lines, line)) {
+            size_t start = line.find_first_not_of(" \t");
+            if (start == string::npos || line.compare(start, 8, "uniform ") != 0 || line.find('{') != string::npos)
+                continue;
+
+            std::istringstream words = std::istringstream(line.substr(start + 8));
+            string type;
+            string name;
+            words >> type >> name;
+            name = name.substr(0, name.find(';'));
+
+            NullUniform uniform = { name, getUniformType(type), 1, nextLocation };
+            size_t bracket = name.find('[');
+            if (bracket != string::npos) {
+                uniform.name = name.substr(0, bracket);
+                uniform.size = std::max(atoi(name.c_str() + bracket + 1), 1);
+            }
+            if (uniform.type == GL_NONE || uniform.name.empty())
+                continue;
+            bool duplicate = false;
+            for (const NullUniform& other : uniforms)
+                duplicate = duplicate || other.name == uniform.name;
+            if (duplicate)
+                continue;
+
+            uniforms.push_back(uniform);
+            nextLocation += uniform.size;
+        }
+    }
+}
+
+static void GLAPIENTRY nullDeleteProgram(GLuint program) {
+    callCounts[NULL_GL_DeleteProgram]++;
+    programShaders.erase(program);
+    programUniforms.erase(program);
+}
+
+static void GLAPIENTRY nullGetProgramiv(GLuint program, GLenum name, GLint* value) {
+    callCounts[NULL_GL_GetProgramiv]++;
+    switch (name) {
+        case GL_LINK_STATUS:
+        case GL_VALIDATE_STATUS:
+            *value = GL_TRUE;
+            break;
+        case GL_ACTIVE_UNIFORMS:
+            *value = (GLint) programUniforms[program].size();
+            break;
+        case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+            *value = 0;
+            for (const NullUniform& uniform : programUniforms[program])
+                *value = std::max(*value, (GLint) uniform.name.size() + 4); //Room for "[0]" and the null terminator
+            break;
+        default:
+            *value = 0;
+            break;
+    }
+}
+
+//NOTE: Arrays are named after their first element, like a driver does.
+static void GLAPIENTRY nullGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) {
+    callCounts[NULL_GL_GetActiveUniform]++;
+    const NullUniform& uniform = programUniforms[program].at(index);
+    string fullName = uniform.size > 1 ? uniform.name + "[0]" : uniform.name;
+    GLsizei written = std::min((GLsizei) fullName.size(), bufSize - 1);
+    memcpy(name, fullName.data(), written);
+    name[written] = '\0';
+    if (length != nullptr)
+        *length = written;
+    *size = uniform.size;
+    *type = uniform.type;
+}
+
+static GLint GLAPIENTRY nullGetUniformLocation(GLuint program, const GLchar* name) {
+    callCounts[NULL_GL_GetUniformLocation]++;
+    string lookup = name;
+    if (lookup.size() > 3 && lookup.compare(lookup.size() - 3, 3, "[0]") == 0)
+        lookup.erase(lookup.size() - 3);
+    for (const NullUniform& uniform : programUniforms[program]) {
+        if (uniform.name == lookup)
+            return uniform.location;
+    }
+    return -1;
+}
+
+static void GLAPIENTRY nullGenFramebuffers(GLsizei count, GLuint* framebuffers) {
+    callCounts[NULL_GL_GenFramebuffers]++;
+    genNames(count, framebuffers);
+}
+
+static GLenum GLAPIENTRY nullCheckFramebufferStatus(GLenum target) {
+    callCounts[NULL_GL_CheckFramebufferStatus]++;
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void GLAPIENTRY nullGenRenderbuffers(GLsizei count, GLuint* renderbuffers) {
+    callCounts[NULL_GL_GenRenderbuffers]++;
+    genNames(count, renderbuffers);
+}
+
+//NOTE: Any non-null pointer will do, since we never look inside.
+static GLsync GLAPIENTRY nullFenceSync(GLenum condition, GLbitfield flags) {
+    callCounts[NULL_GL_FenceSync]++;
+    static char fence;
+    return (GLsync) &fence;
+}
+
+//The "GPU" is always done already.
+static GLenum GLAPIENTRY nullClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+    callCounts[NULL_GL_ClientWaitSync]++;
+    return GL_ALREADY_SIGNALED;
+}
+
+static void GLAPIENTRY nullGenQueries(GLsizei count, GLuint* ids) {
+    callCounts[NULL_GL_GenQueries]++;
+    genNames(count, ids);
+}
+
+//Results are always available (so nothing waits on them), and always 0.
+static void GLAPIENTRY nullGetQueryObjectuiv(GLuint id, GLenum name, GLuint* value) {
+    callCounts[NULL_GL_GetQueryObjectuiv]++;
+    *value = name == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+static void GLAPIENTRY nullGetQueryObjectui64v(GLuint id, GLenum name, GLuint64* value) {
+    callCounts[NULL_GL_GetQueryObjectui64v]++;
+    *value = 0;
+}
+
+static void GLAPIENTRY nullGetIntegerv(GLenum name, GLint* value) {
+    callCounts[NULL_GL_GetIntegerv]++;
+    switch (name) {
+        case GL_MAJOR_VERSION: *value = 4; break;
+        case GL_MINOR_VERSION: *value = 5; break;
+        default:               *value = 0; break;
+    }
+}
+
+static const GLubyte* GLAPIENTRY nullGetString(GLenum name) {
+    callCounts[NULL_GL_GetString]++;
+    switch (name) {
+        case GL_VERSION:    return (const GLubyte*) "4.5 (Null GL)";
+        case GL_RENDERER:   return (const GLubyte*) "Null GL";
+        case GL_VENDOR:     return (const GLubyte*) "Null GL";
+    }
+    return (const GLubyte*) "";
+}
+
+void NullGL::install() {
+    if (installed)
+        return;
+
+#define INSTALL_STUB(pointer, name) pointer = &NullStub<NULL_GL_##name, decltype(pointer)>::call;
+#define INSTALL_FAKE(pointer, name) pointer = &null##name;
+    NULL_GL_FUNCTIONS(INSTALL_STUB, INSTALL_FAKE)
+#undef INSTALL_STUB
+#undef INSTALL_FAKE
+
+    //NOTE: What GLEW would have found out from the context. Everything we stub out is core in OpenGL 4.5,
+    //      but we leave KHR_debug out, so GLCALL falls back to glGetError (which never has anything to say).
+    __GLEW_VERSION_1_1 = __GLEW_VERSION_1_2 = __GLEW_VERSION_1_3 = __GLEW_VERSION_1_4 = __GLEW_VERSION_1_5 = GL_TRUE;
+    __GLEW_VERSION_2_0 = __GLEW_VERSION_2_1 = GL_TRUE;
+    __GLEW_VERSION_3_0 = __GLEW_VERSION_3_1 = __GLEW_VERSION_3_2 = __GLEW_VERSION_3_3 = GL_TRUE;
+    __GLEW_VERSION_4_0 = __GLEW_VERSION_4_1 = __GLEW_VERSION_4_2 = __GLEW_VERSION_4_3 = __GLEW_VERSION_4_4 = __GLEW_VERSION_4_5 = GL_TRUE;
+    __GLEW_KHR_debug = GL_FALSE;
+
+    installed = true;
+    resetCounters();
+}
+
+uint64_t NullGL::getCallCount() {
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < NULL_GL_FUNCTION_COUNT; i++)
+        total += callCounts[i];
+    return total;
+}
+
+void NullGL::resetCounters() {
+    memset(callCounts, 0, sizeof(callCounts));
+}
+
+void NullGL::printCalls() {
+    vector<unsigned int> order;
+    for (unsigned int i = 0; i < NULL_GL_FUNCTION_COUNT; i++) {
+        if (callCounts[i] > 0)
+            order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [](unsigned int a, unsigned int b) {
+        return callCounts[a] > callCounts[b];
+    });
+
+    cout << "Null GL: " << getCallCount() << " GL calls" << endl;
+    for (unsigned int i : order)
+        cout << "    " << FUNCTION_NAMES[i] << ": " << callCounts[i] << endl;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// A stand-in for the OpenGL driver that does nothing (beyond counting calls), so we can measure what the renderer itself costs on the CPU
+/// (sorting, state tracking, batching, allocation) with no driver noise, and without needing a context (or a GPU) at all.
+/// </summary>
+//NOTE: Works like GLTrace, by pointing GLEW's function pointers (and ours, see GLHooks.h) at our own functions, so nothing else has to know.
+//      Install it INSTEAD of initializing GLEW: there must be no context, since nothing reaches it anymore.
+//      We pretend to be OpenGL 4.5, so the renderer takes its fastest paths (persistent mapping, multi-draw indirect).
+//      Buffers do get CPU memory (so mapping them works like it would), but nothing is ever drawn, and every query reads back 0.
+//      Programs do get a uniform table, from the plain uniform declarations in their shaders, so Shader's uniform uploads (and its skipping of repeats) get measured too.
+class NullGL {
+    private:
+    static bool installed;
+
+    public:
+    static void install();
+    inline static bool isInstalled() { return installed; }
+
+    //How many GL calls we've made since installing (or resetCounters)
+    static uint64_t getCallCount();
+    static void resetCounters();
+
+    /// <summary>
+    /// Prints how many times we called each GL function, most called first.
+    /// </summary>
+    static void printCalls();
+};
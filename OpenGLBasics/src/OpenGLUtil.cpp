@@ -5,6 +5,10 @@
 using std::cout;
 using std::endl;
 
+thread_local GLCallRecord glLastCall = { "(none)", "(unknown)", 0 };
+bool glDebugCallbackInstalled = false;
+bool glChecksEnabled = true;
+
 void glClearError() {
     while (glGetError() != GL_NO_ERROR);
 }
@@ -16,4 +20,78 @@ bool glLogCall(const char* function, const char* file, int line) {
         return false;
     }
     return true;
-}
\ No newline at end of file
+}
+
+static const char* getDebugSourceName(GLenum source) {
+    switch (source) {
+        case GL_DEBUG_SOURCE_API:               return "API";
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM:     return "Window System";
+        case GL_DEBUG_SOURCE_SHADER_COMPILER:   return "Shader Compiler";
+        case GL_DEBUG_SOURCE_THIRD_PARTY:       return "Third Party";
+        case GL_DEBUG_SOURCE_APPLICATION:       return "Application";
+    }
+    return "Other";
+}
+
+static const char* getDebugTypeName(GLenum type) {
+    switch (type) {
+        case GL_DEBUG_TYPE_ERROR:               return "Error";
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "Deprecated";
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return "Undefined Behavior";
+        case GL_DEBUG_TYPE_PORTABILITY:         return "Portability";
+        case GL_DEBUG_TYPE_PERFORMANCE:         return "Performance";
+        case GL_DEBUG_TYPE_MARKER:              return "Marker";
+    }
+    return "Other";
+}
+
+static const char* getDebugSeverityName(GLenum severity) {
+    switch (severity) {
+        case GL_DEBUG_SEVERITY_HIGH:            return "high";
+        case GL_DEBUG_SEVERITY_MEDIUM:          return "medium";
+        case GL_DEBUG_SEVERITY_LOW:             return "low";
+    }
+    return "notification";
+}
+
+static void GLAPIENTRY onDebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam) {
+    cout << "[OpenGL " << getDebugTypeName(type) << "] (" << getDebugSourceName(source) << ", " << getDebugSeverityName(severity) << ", " << id << "): "
+        << message << "\n" << glLastCall.function << "\n" << glLastCall.file << ":" << glLastCall.line << endl;
+
+    //NOTE: Same as GLCALL's ASSERT did for glGetError. Everything else is just logged.
+    if (type == GL_DEBUG_TYPE_ERROR)
+        DEBUG_BREAK();
+}
+
+void glSetChecksEnabled(bool enabled) {
+    glChecksEnabled = enabled;
+}
+
+bool glInstallDebugCallback() {
+    glDebugCallbackInstalled = false;
+    if (!GLEW_VERSION_4_3 && !GLEW_KHR_debug) {
+        cout << "KHR_debug isn't available, so OpenGL errors will be checked with glGetError." << endl;
+        return false;
+    }
+
+    //NOTE: These calls aren't wrapped in GLCALL, since GLCALL depends on whether this worked.
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(onDebugMessage, nullptr);
+    glSetDebugSeverity(GL_DEBUG_SEVERITY_LOW);
+
+    glDebugCallbackInstalled = glGetError() == GL_NO_ERROR;
+    return glDebugCallbackInstalled;
+}
+
+void glSetDebugSeverity(GLenum minimumSeverity) {
+    //From least to most severe
+    const GLenum severities[4] = { GL_DEBUG_SEVERITY_NOTIFICATION, GL_DEBUG_SEVERITY_LOW, GL_DEBUG_SEVERITY_MEDIUM, GL_DEBUG_SEVERITY_HIGH };
+
+    bool enabled = false;
+    for (GLenum severity : severities) {
+        if (severity == minimumSeverity)
+            enabled = true;
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, severity, 0, nullptr, enabled ? GL_TRUE : GL_FALSE);
+    }
+}
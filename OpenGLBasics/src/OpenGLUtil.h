@@ -2,12 +2,94 @@
 
 #include <GL/glew.h>
 
+#include "GLHooks.h"
+
 //NOTE: Compiler instrinsic!! __debugbreak() is specific to MSVC!
-#define ASSERT(x) if (!(x)) __debugbreak();
-#define GLCALL(x) glClearError();\
+//      Everywhere else (like our headless Linux builds), raising SIGTRAP does the same job.
+#ifdef _MSC_VER
+#define DEBUG_BREAK() __debugbreak()
+#else
+#include <csignal>
+#define DEBUG_BREAK() raise(SIGTRAP)
+#endif
+
+#define ASSERT(x) if (!(x)) DEBUG_BREAK();
+
+//How GLCALL checks for OpenGL errors. Pick one by defining GL_CHECK_LEVEL for the build:
+//  GL_CHECK_OFF:       Not at all. GLCALL(x) is just x.
+//  GL_CHECK_CALLBACK:  OpenGL reports errors to our KHR_debug callback (see glInstallDebugCallback), and GLCALL only records which call it's making,
+//                      so the callback can say where the error came from. No glGetError round-trips, unless the callback isn't available.
+//  GL_CHECK_SYNC:      glGetError before and after every call. The slowest, but it works on any context.
+#define GL_CHECK_OFF 0
+#define GL_CHECK_CALLBACK 1
+#define GL_CHECK_SYNC 2
+
+#ifndef GL_CHECK_LEVEL
+#define GL_CHECK_LEVEL GL_CHECK_CALLBACK
+#endif
+
+#if GL_CHECK_LEVEL == GL_CHECK_OFF
+#define GLCALL(x) x
+#elif GL_CHECK_LEVEL == GL_CHECK_CALLBACK
+#define GLCALL(x) glSetLastCall(#x, __FILE__, __LINE__);\
+    if (glAreChecksEnabled() && !glIsDebugCallbackInstalled()) glClearError();\
     x;\
-    ASSERT(glLogCall(#x, __FILE__, __LINE__))
+    ASSERT(!glAreChecksEnabled() || glIsDebugCallbackInstalled() || glLogCall(#x, __FILE__, __LINE__))
+#else
+#define GLCALL(x) if (glAreChecksEnabled()) glClearError();\
+    x;\
+    ASSERT(!glAreChecksEnabled() || glLogCall(#x, __FILE__, __LINE__))
+#endif
+
+/// <summary>
+/// The last call made through GLCALL on this thread, so the debug callback can tell which of our calls an error came from.
+/// </summary>
+struct GLCallRecord {
+    const char* function;
+    const char* file;
+    int line;
+};
+
+extern thread_local GLCallRecord glLastCall;
+
+inline void glSetLastCall(const char* function, const char* file, int line) {
+    glLastCall.function = function;
+    glLastCall.file = file;
+    glLastCall.line = line;
+}
 
 void glClearError();
 
-bool glLogCall(const char* function, const char* file, int line);
\ No newline at end of file
+bool glLogCall(const char* function, const char* file, int line);
+
+/// <summary>
+/// Routes OpenGL's errors and warnings to our callback, which logs them with the last GLCALL's location (and breaks on errors).
+/// Needs OpenGL 4.3 or KHR_debug, and ideally a debug context (see glWantsDebugContext). Returns false if it's not available,
+/// in which case GLCALL falls back to glGetError.
+/// </summary>
+//NOTE: Also turns on synchronous debug output, so the callback runs inside the call that caused the message, while glLastCall still points at it.
+bool glInstallDebugCallback();
+
+extern bool glDebugCallbackInstalled;
+
+inline bool glIsDebugCallbackInstalled() { return glDebugCallbackInstalled; }
+
+/// <summary>
+/// Turns GLCALL's error checks off (or back on) at runtime, whatever GL_CHECK_LEVEL the build has. On by default.
+/// </summary>
+//NOTE: For KHR_no_error contexts, which never report errors, so checking would only cost us a glGetError round-trip per call.
+void glSetChecksEnabled(bool enabled);
+
+extern bool glChecksEnabled;
+
+inline bool glAreChecksEnabled() { return glChecksEnabled; }
+
+/// <summary>
+/// Only report messages at least this severe: GL_DEBUG_SEVERITY_NOTIFICATION, _LOW, _MEDIUM or _HIGH. Defaults to _LOW, since notifications are chatty.
+/// </summary>
+void glSetDebugSeverity(GLenum minimumSeverity);
+
+/// <summary>
+/// Whether contexts should be created with the debug flag, which some drivers need before they'll report anything to the callback.
+/// </summary>
+constexpr bool glWantsDebugContext() { return GL_CHECK_LEVEL == GL_CHECK_CALLBACK; }
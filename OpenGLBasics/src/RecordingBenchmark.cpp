@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "OpenGLUtil.h"
+#include "Benchmark.h"
+#include "CpuProfiler.h"
+#include "RecordingBenchmark.h"
+
+using std::cout;
+using std::endl;
+
+static const float QUAD_POSITIONS[8] = {
+    0.5f,   -0.5f,
+    -0.5f,  -0.5f,
+    0.5f,   0.5f,
+    -0.5f,  0.5f
+};
+
+static const unsigned int QUAD_INDICES[6] = {
+    0, 1, 2,
+    3, 2, 1
+};
+
+//How far out the objects go. The screen only shows -1 to 1, so most of them are culled at any one time.
+static const float SCENE_EXTENT = 3.0f;
+
+//Half the size of each quad on screen (Instanced.glsl scales the quad by 0.1)
+static const float OBJECT_RADIUS = 0.05f;
+
+//Scatters the objects with a fixed seed, so every run records exactly the same scene.
+vector<RecordingBenchmark::SceneObject> RecordingBenchmark::generateObjects(unsigned int count) {
+    vector<SceneObject> objects = vector<SceneObject>(count);
+    uint32_t seed = 12345;
+    for (unsigned int i = 0; i < count; i++) {
+        SceneObject& object = objects[i];
+        seed = seed * 1664525u + 1013904223u;
+        object.x = ((seed >> 8) / 16777216.0f * 2 - 1) * SCENE_EXTENT;
+        seed = seed * 1664525u + 1013904223u;
+        object.y = ((seed >> 8) / 16777216.0f * 2 - 1) * SCENE_EXTENT;
+        object.color[0] = (float) (i % 7) / 7;
+        object.color[1] = 0.3f;
+        object.color[2] = (float) (i % 11) / 11;
+        object.color[3] = 1;
+    }
+    return objects;
+}
+
+RecordingBenchmark::RecordingBenchmark()
+    : objects(generateObjects(OBJECT_COUNT)),
+    va(),
+    vb(QUAD_POSITIONS, sizeof(QUAD_POSITIONS)),
+    instanceVb(objects.data(), OBJECT_COUNT * sizeof(SceneObject)),
+    ib(QUAD_INDICES, 6),
+    shader("res/shaders/Instanced.glsl"),
+    frameLayout(),
+    tintOffset(frameLayout.push(4)),
+    timeOffset(frameLayout.push(1)),
+    frameUniforms("Frame", frameLayout.getSize()),
+    renderer() {
+
+    VertexBufferLayout layout;
+    layout.push<float>(2);
+    va.addBuffer(vb, layout);
+    VertexBufferLayout instanceLayout;
+    instanceLayout.push<float>(2, 1); //offset
+    instanceLayout.push<float>(4, 1); //color
+    va.addBuffer(instanceVb, instanceLayout);
+}
+
+bool RecordingBenchmark::isSupported() {
+    return GLEW_VERSION_4_2 || GLEW_ARB_base_instance;
+}
+
+//NOTE: Does on the CPU what Instanced.glsl does to each instance, so we know which ones end up on screen.
+void RecordingBenchmark::recordObjects(unsigned int begin, unsigned int end, float time, CommandBuffer& commands) const {
+    float s = sin(time * 0.5f);
+    float c = cos(time * 0.5f);
+    for (unsigned int i = begin; i < end; i++) {
+        const SceneObject& object = objects[i];
+        float x = object.x * c - object.y * s;
+        float y = object.x * s + object.y * c;
+        if (std::abs(x) > 1 + OBJECT_RADIUS || std::abs(y) > 1 + OBJECT_RADIUS)
+            continue;
+
+        //Sorted by distance from the center, and by color, standing in for a material
+        float depth = std::sqrt(x * x + y * y) / (SCENE_EXTENT * 1.5f);
+        unsigned int material = (unsigned int) (object.color[0] * 7 + 0.5f);
+        commands.submitInstanced(va, ib, shader, 1, i, 0, material, depth);
+    }
+}
+
+void RecordingBenchmark::run(unsigned int threadCount, unsigned int warmupFrames, unsigned int measuredFrames) {
+    if (threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    TimingSummary single = Benchmark::summarize(runWith(1, warmupFrames, measuredFrames));
+    if (threadCount == 1)
+        return;
+    TimingSummary multiple = Benchmark::summarize(runWith(threadCount, warmupFrames, measuredFrames));
+    cout << "Recording was " << std::setprecision(2) << single.mean / multiple.mean << "x as fast on " << threadCount << " threads as on 1." << endl;
+}
+
+vector<double> RecordingBenchmark::runWith(unsigned int threadCount, unsigned int warmupFrames, unsigned int measuredFrames) {
+    typedef std::chrono::steady_clock Clock;
+
+    CommandRecorder recorder(threadCount);
+    vector<double> recordTimes;
+    vector<double> submitTimes;
+    size_t visibleObjects = 0;
+    for (unsigned int frame = 0; frame < warmupFrames + measuredFrames; frame++) {
+        PROFILE_SCOPE("Frame");
+        float time = frame / 60.0f;
+        frameUniforms.setVec4(tintOffset, 1, 1, 1, 1);
+        frameUniforms.setFloat(timeOffset, time);
+        frameUniforms.upload();
+
+        Clock::time_point start = Clock::now();
+        recorder.record(OBJECT_COUNT, [this, time](unsigned int begin, unsigned int end, CommandBuffer& commands) {
+            recordObjects(begin, end, time, commands);
+        });
+        Clock::time_point recorded = Clock::now();
+
+        //NOTE: Waits for the GPU too, so drawing one frame doesn't overlap recording the next.
+        renderer.clear();
+        const vector<CommandBuffer>& commandBuffers = recorder.getCommandBuffers();
+        renderer.submit(commandBuffers);
+        renderer.flush();
+        glFinish();
+        Clock::time_point submitted = Clock::now();
+
+        if (frame < warmupFrames)
+            continue;
+        recordTimes.push_back(std::chrono::duration<double, std::milli>(recorded - start).count());
+        submitTimes.push_back(std::chrono::duration<double, std::milli>(submitted - recorded).count());
+        visibleObjects = 0;
+        for (const CommandBuffer& commands : commandBuffers)
+            visibleObjects += commands.getCount();
+    }
+
+    TimingSummary record = Benchmark::summarize(recordTimes);
+    TimingSummary submit = Benchmark::summarize(submitTimes);
+    cout << "Recording " << OBJECT_COUNT << " objects (" << visibleObjects << " visible) on " << recorder.getThreadCount() << " thread(s), in milliseconds:" << endl
+        << std::fixed << std::setprecision(3)
+        << "  record  mean " << std::setw(8) << record.mean << "  p95 " << std::setw(8) << record.p95 << endl
+        << "  submit  mean " << std::setw(8) << submit.mean << "  p95 " << std::setw(8) << submit.p95 << "  (merge, sort and draw, on the GL thread)" << endl;
+    return recordTimes;
+}
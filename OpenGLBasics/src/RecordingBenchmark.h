@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include "CommandRecorder.h"
+#include "IndexBuffer.h"
+#include "Renderer.h"
+#include "Shader.h"
+#include "UniformBuffer.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+using std::vector;
+
+/// <summary>
+/// Measures how recording draws scales across threads (see --record-threads). Each frame, a CommandRecorder's threads walk a scene of
+/// OBJECT_COUNT small quads (animating, culling and sorting each one into a packet), then the GL thread merges, sorts and draws the packets.
+/// The same frames are run with 1 thread, then with N, so the two can be compared.
+/// </summary>
+//NOTE: Each object is one instance of the quad, drawn by itself with its own base instance, so it needs OpenGL 4.2 (or ARB_base_instance).
+//      Most objects are off screen at any one time, so the recording (which visits every object) outweighs the drawing (which only sees the visible ones).
+class RecordingBenchmark {
+    public:
+    static const unsigned int OBJECT_COUNT = 1 << 16;
+
+    private:
+    //Per object, where it is (before the scene rotates) and its color. Also exactly its instance attributes, so it's uploaded as is.
+    struct SceneObject {
+        float x, y;
+        float color[4];
+    };
+
+    vector<SceneObject> objects;
+
+    VertexArray va;
+    VertexBuffer vb;
+    VertexBuffer instanceVb;
+    IndexBuffer ib;
+    Shader shader;
+
+    Std140Layout frameLayout;
+    unsigned int tintOffset;
+    unsigned int timeOffset;
+    UniformBuffer frameUniforms;
+
+    Renderer renderer;
+
+    public:
+    RecordingBenchmark();
+
+    static bool isSupported();
+
+    /// <summary>
+    /// Renders warmupFrames + measuredFrames frames with 1 recording thread, then again with threadCount (0 for one per core),
+    /// and prints how long recording, and then merging, sorting and drawing, took per measured frame with each.
+    /// </summary>
+    void run(unsigned int threadCount, unsigned int warmupFrames, unsigned int measuredFrames);
+
+    private:
+    static vector<SceneObject> generateObjects(unsigned int count);
+
+    //Returns the times spent recording each measured frame
+    vector<double> runWith(unsigned int threadCount, unsigned int warmupFrames, unsigned int measuredFrames);
+    void recordObjects(unsigned int begin, unsigned int end, float time, CommandBuffer& commands) const;
+};
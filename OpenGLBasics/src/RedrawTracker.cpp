@@ -0,0 +1,22 @@
+#include <iostream>
+
+#include "RedrawTracker.h"
+
+using std::cout;
+using std::endl;
+
+RedrawTracker& RedrawTracker::get() {
+    static RedrawTracker tracker;
+    return tracker;
+}
+
+//NOTE: Starts dirty, since nothing's been drawn yet.
+RedrawTracker::RedrawTracker()
+    : dirty(true),
+    incomplete(false),
+    renderedFrames(0),
+    idleWakeups(0) { }
+
+void RedrawTracker::print() const {
+    cout << "Rendered " << renderedFrames << " frames on demand, and skipped " << idleWakeups << " wake-ups with nothing to redraw." << endl;
+}
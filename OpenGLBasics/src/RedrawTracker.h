@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// Tracks whether anything on screen could have changed since the last frame we presented, so a mostly static app (like a dashboard)
+/// can skip redrawing identical frames and sleep until something happens instead (see --on-demand).
+/// </summary>
+//NOTE: The resource classes invalidate it whenever they upload anything (buffer data, uniforms), and the app does for input and window events.
+//      Uploads made while drawing a frame end up in that frame, so onFrameRendered() forgets them. Only changes made between frames cause a redraw.
+//      Like RenderStats, there's just one (see get()).
+class RedrawTracker {
+    private:
+    bool dirty;
+    bool incomplete;        //The frame being drawn is missing something that isn't ready yet, so it'll need drawing again
+    uint64_t renderedFrames;
+    uint64_t idleWakeups;   //Times we woke up (from an event or timeout) with nothing to redraw
+
+    public:
+    static RedrawTracker& get();
+
+    RedrawTracker();
+
+    inline void invalidate() { dirty = true; }
+    inline bool needsRedraw() const { return dirty; }
+
+    /// <summary>
+    /// Call while drawing a frame that's missing something (like a shader that's still compiling, see Renderer::resolveShader),
+    /// so we draw another one after it, instead of sleeping on an incomplete frame.
+    /// </summary>
+    //NOTE: Unlike invalidate(), this survives onFrameRendered().
+    inline void invalidateNextFrame() { incomplete = true; }
+
+    /// <summary>
+    /// Call once a frame's been presented: everything that changed so far is in it.
+    /// </summary>
+    inline void onFrameRendered() {
+        dirty = incomplete;
+        incomplete = false;
+        renderedFrames++;
+    }
+    inline void onIdleWakeup() { idleWakeups++; }
+
+    void print() const;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "VertexBufferLayout.h"
+
+using std::string;
+using std::vector;
+
+class SoftwareShader;
+
+//NOTE: Handles are just ids into whichever backend made them, with 0 meaning none. They're separate types so they can't get mixed up.
+struct BufferHandle {
+    unsigned int id;
+};
+
+struct PipelineHandle {
+    unsigned int id;
+};
+
+struct CommandListHandle {
+    unsigned int id;
+};
+
+enum class BufferType {
+    VERTEX,
+    INDEX   //Always unsigned int indices
+};
+
+//How many vec4s of frame and draw constants there are (see RenderBackend)
+static const unsigned int BACKEND_CONSTANT_COUNT = 4;
+
+/// <summary>
+/// Everything that's fixed about how a draw is done: its shader and its vertex layout.
+/// </summary>
+//NOTE: Each backend takes its shader in the form it understands, so a pipeline meant for every backend sets all of them.
+struct PipelineDesc {
+    string shaderPath;                      //GLSL (see Shader), for the GL backend
+    const SoftwareShader* softwareShader;   //For the software backend. Must outlive the pipeline.
+    VertexBufferLayout layout;
+};
+
+struct DrawCommand {
+    PipelineHandle pipeline;
+    BufferHandle vertexBuffer;
+    BufferHandle indexBuffer;
+    unsigned int indexCount;
+    unsigned int firstIndex;
+    float constants[BACKEND_CONSTANT_COUNT][4];
+};
+
+/// <summary>
+/// What the demo needs from a graphics API (buffers, pipelines and draws), so the same code can render with OpenGL, or entirely on the CPU.
+/// </summary>
+//NOTE: Shaders get two sets of BACKEND_CONSTANT_COUNT vec4s:
+//      - Frame constants, set once per frame with setFrameConstants(). GLSL: layout(std140) uniform FrameConstants { vec4 u_Frame[4]; };
+//      - Draw constants, from each DrawCommand. GLSL: uniform vec4 u_Draw[4];
+//      The software backend hands its shaders the frame constants, followed by the draw constants, as its uniforms.
+//
+//      Draws that don't change from frame to frame should be recorded into a command list once, then submitted every frame.
+//      Recording is where the backend does all its lookups and checks (and, for an API like Vulkan, would build its command buffer),
+//      so submitting is as cheap as the backend can make a draw. Anything that changes every frame belongs in buffers or frame constants.
+//
+//TODO: A Vulkan backend. It needs the Vulkan headers and a loader in Dependencies (we only have GLEW and GLFW so far), and Mesa's lavapipe to run on the CPU.
+//      The interface is already shaped for it:
+//      - createPipeline() -> VkPipeline (SPIR-V from PipelineDesc, through a VkPipelineCache saved to disk between runs)
+//      - recordCommands() -> a secondary VkCommandBuffer, recorded once. submit() executes it inside the frame's primary one.
+//      - Frame constants -> a uniform buffer in a descriptor set. Draw constants -> push constants.
+//      - beginFrame()/endFrame() -> a render pass into an offscreen image, waiting on a fence before reusing its command buffer.
+class RenderBackend {
+    public:
+    virtual ~RenderBackend() { }
+
+    virtual const char* getName() const = 0;
+
+    virtual BufferHandle createBuffer(BufferType type, const void* data, unsigned int size) = 0;
+
+    //NOTE: Only vertex buffers can be updated, and only within the size they were created with.
+    virtual void updateBuffer(BufferHandle buffer, const void* data, unsigned int size, unsigned int offset = 0) = 0;
+    virtual void destroyBuffer(BufferHandle buffer) = 0;
+
+    virtual PipelineHandle createPipeline(const PipelineDesc& desc) = 0;
+    virtual void destroyPipeline(PipelineHandle pipeline) = 0;
+
+    //NOTE: Every buffer and pipeline a command list uses must outlive it.
+    virtual CommandListHandle recordCommands(const vector<DrawCommand>& draws) = 0;
+    virtual void destroyCommands(CommandListHandle commands) = 0;
+
+    virtual void beginFrame(float r, float g, float b, float a) = 0;
+    virtual void setFrameConstants(const float constants[BACKEND_CONSTANT_COUNT][4]) = 0;
+    virtual void submit(CommandListHandle commands) = 0;
+
+    //For draws that change every frame, without recording them first
+    virtual void draw(const DrawCommand& command) = 0;
+
+    virtual void endFrame() = 0;
+
+    /// <summary>
+    /// Reads back the last frame, as tightly packed RGBA8 rows, bottom row first (like <see cref="Framebuffer::readPixels"/>).
+    /// </summary>
+    virtual void readPixels(vector<unsigned char>& pixels) = 0;
+};
@@ -0,0 +1,37 @@
+#include <iostream>
+
+#include "RenderStats.h"
+
+using std::cout;
+using std::endl;
+
+RenderStats& RenderStats::get() {
+    static RenderStats stats;
+    return stats;
+}
+
+RenderStats::RenderStats()
+    : current(),
+    last(),
+    live(),
+    frame(0),
+    logInterval(0) { }
+
+void RenderStats::endFrame() {
+    last = current;
+    current = FrameStats();
+    frame++;
+
+    if (logInterval != 0 && frame % logInterval == 0)
+        print();
+}
+
+void RenderStats::print() const {
+    cout << "Frame " << frame << ": "
+        << last.drawCalls << " draw calls, "
+        << last.triangles << " triangles, "
+        << last.programBinds << " program / " << last.vertexArrayBinds << " VAO / " << last.bufferBinds << " buffer binds, "
+        << last.uniformUploads << " uniform uploads (" << last.uniformUploadsSkipped << " skipped), "
+        << last.bytesUploaded / 1024.0 << " KB uploaded. Alive: "
+        << live.buffers << " buffers, " << live.vertexArrays << " VAOs, " << live.programs << " programs" << endl;
+}
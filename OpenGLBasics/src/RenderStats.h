@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+struct FrameStats {
+    unsigned int drawCalls;
+    uint64_t triangles;
+    unsigned int programBinds;      //Only the binds that actually reached OpenGL (see GLStateCache)
+    unsigned int vertexArrayBinds;
+    unsigned int bufferBinds;
+    unsigned int uniformUploads;    //glUniform* calls, plus uniform buffer uploads
+    unsigned int uniformUploadsSkipped; //glUniform* calls we didn't make, since the value was what we'd last uploaded (see Shader::setUniform)
+    uint64_t bytesUploaded;         //Into buffers, whether with glBufferData, glBufferSubData or by writing to mapped memory
+};
+
+//NOTE: Not per frame, these are just however many exist right now.
+struct LiveObjectCounts {
+    unsigned int buffers;
+    unsigned int vertexArrays;
+    unsigned int programs;
+};
+
+/// <summary>
+/// Counts what each frame costs us in OpenGL terms (draws, triangles, binds, uploads...), so we can budget frames and spot batching regressions.
+/// The Renderer and the resource classes report into it as they go.
+/// </summary>
+//NOTE: Like GLStateCache, there's just one (see get()), since there's just one context.
+class RenderStats {
+    private:
+    FrameStats current;
+    FrameStats last;
+    LiveObjectCounts live;
+    unsigned int frame;
+    unsigned int logInterval;
+
+    public:
+    static RenderStats& get();
+
+    RenderStats();
+
+    //NOTE: A multi-draw counts as one draw call, since it's one call into the driver.
+    inline void onDraw(uint64_t triangleCount) {
+        current.drawCalls++;
+        current.triangles += triangleCount;
+    }
+    inline void onProgramBind() { current.programBinds++; }
+    inline void onVertexArrayBind() { current.vertexArrayBinds++; }
+    inline void onBufferBind() { current.bufferBinds++; }
+    inline void onUniformUpload() { current.uniformUploads++; }
+    inline void onUniformSkipped() { current.uniformUploadsSkipped++; }
+    inline void onBufferUpload(uint64_t size) { current.bytesUploaded += size; }
+
+    inline void onBufferCreated() { live.buffers++; }
+    inline void onBufferDeleted() { live.buffers--; }
+    inline void onVertexArrayCreated() { live.vertexArrays++; }
+    inline void onVertexArrayDeleted() { live.vertexArrays--; }
+    inline void onProgramCreated() { live.programs++; }
+    inline void onProgramDeleted() { live.programs--; }
+
+    /// <summary>
+    /// Starts counting a new frame. What we counted so far becomes getLastFrame(), and gets logged if it's time to.
+    /// </summary>
+    void endFrame();
+
+    /// <summary>
+    /// Log the last frame's stats every interval frames, or never with 0 (the default).
+    /// </summary>
+    inline void setLogInterval(unsigned int interval) { logInterval = interval; }
+
+    //The frame we're counting right now, so far
+    inline const FrameStats& getCurrentFrame() const { return current; }
+    inline const FrameStats& getLastFrame() const { return last; }
+    inline const LiveObjectCounts& getLiveObjects() const { return live; }
+
+    void print() const;
+};
@@ -1,15 +1,230 @@
 #include "OpenGLUtil.h"
 #include "Renderer.h"
+#include "CpuProfiler.h"
+#include "GpuProfiler.h"
+#include "RedrawTracker.h"
+#include "RenderStats.h"
+
+Renderer::Renderer()
+    : fallbackShader(nullptr) { }
 
 void Renderer::clear() const {
     GLCALL(glClear(GL_COLOR_BUFFER_BIT));
 }
 
 void Renderer::draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const {
-    shader.bind();
+    PROFILE_SCOPE("Renderer::draw");
+    const Shader* readyShader = resolveShader(shader);
+    if (readyShader == nullptr)
+        return;
+    readyShader->bind();
+    va.bind();
+    ib.bind();
+    drawElements(ib, 1, 0);
+}
+
+void Renderer::drawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, unsigned int baseInstance) const {
+    const Shader* readyShader = resolveShader(shader);
+    if (readyShader == nullptr)
+        return;
+    readyShader->bind();
+    va.bind();
+    ib.bind();
+    drawElements(ib, instanceCount, baseInstance);
+}
+
+void Renderer::drawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const IndirectBuffer& commands) const {
+    const Shader* readyShader = resolveShader(shader);
+    if (commands.getUploadedCount() == 0 || readyShader == nullptr)
+        return;
+
+    readyShader->bind();
     va.bind();
     ib.bind();
 
-    //MODERN OpenGL! Issuing a draw call!
-    GLCALL(glDrawElements(GL_TRIANGLES, ib.getCount(), GL_UNSIGNED_INT, NULL)); //REQUIRES an index buffer, and NULL for using the already-bound GL_ELEMENT_ARRAY_BUFFER slot.
+    uint64_t triangleCount = commands.getUploadedTriangleCount();
+    if (!commands.usesFallback()) {
+        RenderStats::get().onDraw(triangleCount);
+        commands.bind();
+        GLCALL(glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, NULL, commands.getUploadedCount(), 0));
+        return;
+    }
+
+    //NOTE: glMultiDrawElementsBaseVertex needs OpenGL 3.2 (or ARB_draw_elements_base_vertex), and it can't do instancing.
+    bool hasBaseVertex = GLEW_VERSION_3_2 || GLEW_ARB_draw_elements_base_vertex;
+    if (!commands.isInstanced() && hasBaseVertex) {
+        RenderStats::get().onDraw(triangleCount);
+        //NOTE: GLEW's prototype for this one takes non-const arrays, even though OpenGL only reads them.
+        GLCALL(glMultiDrawElementsBaseVertex(GL_TRIANGLES, const_cast<int*>(commands.getFallbackCounts().data()), GL_UNSIGNED_INT,
+            const_cast<void**>(commands.getFallbackOffsets().data()), commands.getUploadedCount(), const_cast<int*>(commands.getFallbackBaseVertices().data())));
+        return;
+    }
+
+    //Otherwise, we're back to one call per command.
+    const vector<DrawElementsIndirectCommand>& list = commands.getFallbackCommands();
+    for (unsigned int i = 0; i < list.size(); i++) {
+        const DrawElementsIndirectCommand& command = list[i];
+        RenderStats::get().onDraw((uint64_t) (command.count / 3) * command.instanceCount);
+        if (command.baseInstance != 0) {
+            ASSERT(GLEW_VERSION_4_2 || GLEW_ARB_base_instance);
+            GLCALL(glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, command.count, GL_UNSIGNED_INT,
+                commands.getFallbackOffsets()[i], command.instanceCount, command.baseVertex, command.baseInstance));
+        } else if (hasBaseVertex) {
+            GLCALL(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.count, GL_UNSIGNED_INT,
+                commands.getFallbackOffsets()[i], command.instanceCount, command.baseVertex));
+        } else {
+            //NOTE: Without base vertices, the indices have to be right as they are.
+            ASSERT(command.baseVertex == 0);
+            GLCALL(glDrawElementsInstanced(GL_TRIANGLES, command.count, GL_UNSIGNED_INT, commands.getFallbackOffsets()[i], command.instanceCount));
+        }
+    }
+}
+
+void Renderer::submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int pass, unsigned int material, float depth) {
+    submitInstanced(va, ib, shader, 1, 0, pass, material, depth);
+}
+
+void Renderer::submitInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, unsigned int baseInstance,
+    unsigned int pass, unsigned int material, float depth) {
+    queue.push_back(CommandBuffer::makePacket(va, ib, shader, instanceCount, baseInstance, pass, material, depth));
+}
+
+void Renderer::submit(const CommandBuffer& commands) {
+    const vector<DrawPacket>& packets = commands.getPackets();
+    queue.insert(queue.end(), packets.begin(), packets.end());
+}
+
+void Renderer::submit(const vector<CommandBuffer>& commandBuffers) {
+    size_t total = queue.size();
+    for (const CommandBuffer& commands : commandBuffers)
+        total += commands.getCount();
+    queue.reserve(total);
+
+    for (const CommandBuffer& commands : commandBuffers)
+        submit(commands);
+}
+
+static const char* const PASS_REGION_NAMES[16] = {
+    "Renderer pass 0", "Renderer pass 1", "Renderer pass 2", "Renderer pass 3",
+    "Renderer pass 4", "Renderer pass 5", "Renderer pass 6", "Renderer pass 7",
+    "Renderer pass 8", "Renderer pass 9", "Renderer pass 10", "Renderer pass 11",
+    "Renderer pass 12", "Renderer pass 13", "Renderer pass 14", "Renderer pass 15"
+};
+
+void Renderer::flush() {
+    PROFILE_SCOPE("Renderer::flush");
+    GpuProfiler::Scope flushScope("Renderer::flush");
+    sortQueue();
+
+    const Shader* requestedShader = nullptr; //What the last packet asked for, and what we resolved it to
+    const Shader* resolvedShader = nullptr;
+    const Shader* currentShader = nullptr;
+    const VertexArray* currentVa = nullptr;
+    const IndexBuffer* currentIb = nullptr;
+
+    //Each pass is timed as its own region, inside the flush's.
+    GpuProfiler& profiler = GpuProfiler::get();
+    bool profiling = profiler.isEnabled();
+    unsigned int currentPass = 0xFFFFFFFF;
+
+    for (const DrawPacket& packet : queue) {
+        unsigned int pass = (unsigned int) (packet.sortKey >> 60);
+        if (profiling && pass != currentPass) {
+            if (currentPass != 0xFFFFFFFF)
+                profiler.end();
+            profiler.begin(PASS_REGION_NAMES[pass]);
+            currentPass = pass;
+        }
+
+        if (packet.shader != requestedShader) {
+            requestedShader = packet.shader;
+            resolvedShader = resolveShader(*packet.shader);
+        }
+        if (resolvedShader == nullptr)
+            continue;
+        if (resolvedShader != currentShader) {
+            resolvedShader->bind();
+            currentShader = resolvedShader;
+        }
+
+        //NOTE: The GL_ELEMENT_ARRAY_BUFFER binding is part of the VAO's state, so switching VAOs means we have to rebind the index buffer too.
+        if (packet.va != currentVa) {
+            packet.va->bind();
+            currentVa = packet.va;
+            currentIb = nullptr;
+        }
+        if (packet.ib != currentIb) {
+            packet.ib->bind();
+            currentIb = packet.ib;
+        }
+
+        drawElements(*packet.ib, packet.instanceCount, packet.baseInstance);
+    }
+    if (profiling && currentPass != 0xFFFFFFFF)
+        profiler.end();
+
+    queue.clear();
+}
+
+void Renderer::sortQueue() {
+    //LSD radix sort on the 64-bit keys, 8 bits at a time.
+    //It's stable and O(n), which beats std::sort once we're into the tens of thousands of draws per frame.
+    size_t count = queue.size();
+    if (count < 2)
+        return;
+
+    sortScratch.resize(count);
+    DrawPacket* src = queue.data();
+    DrawPacket* dst = sortScratch.data();
+
+    for (unsigned int shift = 0; shift < 64; shift += 8) {
+        size_t offsets[256] = { };
+        for (size_t i = 0; i < count; i++)
+            offsets[(src[i].sortKey >> shift) & 0xFF]++;
+
+        //Every key has the same byte here (very common for the pass and material fields), so this pass wouldn't move anything.
+        if (offsets[(src[0].sortKey >> shift) & 0xFF] == count)
+            continue;
+
+        size_t total = 0;
+        for (unsigned int b = 0; b < 256; b++) {
+            size_t bucketSize = offsets[b];
+            offsets[b] = total;
+            total += bucketSize;
+        }
+
+        for (size_t i = 0; i < count; i++)
+            dst[offsets[(src[i].sortKey >> shift) & 0xFF]++] = src[i];
+
+        DrawPacket* temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != queue.data())
+        queue.swap(sortScratch);
+}
+
+void Renderer::drawElements(const IndexBuffer& ib, unsigned int instanceCount, unsigned int baseInstance) const {
+    RenderStats::get().onDraw((uint64_t) (ib.getCount() / 3) * instanceCount);
+    if (instanceCount == 1 && baseInstance == 0) {
+        //MODERN OpenGL! Issuing a draw call!
+        GLCALL(glDrawElements(GL_TRIANGLES, ib.getCount(), GL_UNSIGNED_INT, NULL)); //REQUIRES an index buffer, and NULL for using the already-bound GL_ELEMENT_ARRAY_BUFFER slot.
+    } else if (baseInstance == 0) {
+        GLCALL(glDrawElementsInstanced(GL_TRIANGLES, ib.getCount(), GL_UNSIGNED_INT, NULL, instanceCount));
+    } else {
+        ASSERT(GLEW_VERSION_4_2 || GLEW_ARB_base_instance);
+        GLCALL(glDrawElementsInstancedBaseInstance(GL_TRIANGLES, ib.getCount(), GL_UNSIGNED_INT, NULL, instanceCount, baseInstance));
+    }
+}
+
+const Shader* Renderer::resolveShader(const Shader& shader) const {
+    if (shader.isReady())
+        return &shader;
+
+    //NOTE: Either way, this frame isn't what it will look like once the shader's done, so keep drawing frames until it is (for --on-demand).
+    RedrawTracker::get().invalidateNextFrame();
+    if (fallbackShader != nullptr && fallbackShader->isReady())
+        return fallbackShader;
+    return nullptr;
 }
@@ -1,11 +1,73 @@
 #pragma once
 
+#include <vector>
+
+#include "CommandBuffer.h"
 #include "IndexBuffer.h"
+#include "IndirectBuffer.h"
 #include "Shader.h"
 #include "VertexArray.h"
 
+using std::vector;
+
+//NOTE: Draws with a Shader that isn't ready yet (see ShaderCompileMode::ASYNC) use the fallback shader instead, if there is one
+//      (and it's ready), or are skipped, so a frame never waits on the driver to finish compiling.
 class Renderer {
+    private:
+    vector<DrawPacket> queue;
+    vector<DrawPacket> sortScratch;
+    const Shader* fallbackShader;
+
     public:
+    Renderer();
+
+    /// <summary>
+    /// What to draw with in place of a shader that isn't ready yet, or nullptr to skip those draws. It must use the same vertex attributes (or fewer).
+    /// </summary>
+    inline void setFallbackShader(const Shader* shader) { fallbackShader = shader; }
+
     void clear() const;
     void draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+
+    /// <summary>
+    /// Draws instanceCount copies of the mesh in a single call. Per-instance data comes from attributes pushed with a divisor (see <see cref="VertexBufferLayout::push"/>).
+    /// </summary>
+    /// <param name="baseInstance">The first instance to read per-instance attributes from. Anything but 0 requires OpenGL 4.2 or ARB_base_instance.</param>
+    void drawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, unsigned int baseInstance = 0) const;
+
+    /// <summary>
+    /// Draws every command in the bucket with a single glMultiDrawElementsIndirect call, or with glMultiDrawElementsBaseVertex when indirect draws aren't supported.
+    /// The commands index into ib, so all the bucket's meshes must be packed into the VAO's vertex buffers and ib.
+    /// </summary>
+    //NOTE: Remember to call IndirectBuffer::upload() after changing its commands.
+    void drawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const IndirectBuffer& commands) const;
+
+    /// <summary>
+    /// Records a draw without touching OpenGL. Nothing is drawn until <see cref="flush"/> is called.
+    /// </summary>
+    void submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int pass = 0, unsigned int material = 0, float depth = 0);
+    void submitInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, unsigned int baseInstance = 0,
+        unsigned int pass = 0, unsigned int material = 0, float depth = 0);
+
+    /// <summary>
+    /// Queues every packet recorded into commands (e.g. by a worker thread), to be merged and sorted with everything else at the next <see cref="flush"/>.
+    /// </summary>
+    //NOTE: Only call this on the GL thread, after the thread recording into commands is done with it.
+    void submit(const CommandBuffer& commands);
+    void submit(const vector<CommandBuffer>& commandBuffers);
+
+    /// <summary>
+    /// Sorts every draw submitted since the last flush by its sort key, then issues them, only rebinding what changed between draws.
+    /// </summary>
+    //NOTE: While the GpuProfiler is enabled, the whole flush and each pass within it are timed as regions.
+    void flush();
+
+    private:
+    void sortQueue();
+
+    //The shader to actually draw with in place of shader, or nullptr if there's none ready
+    const Shader* resolveShader(const Shader& shader) const;
+
+    //Issues the draw call itself, assuming everything is already bound.
+    void drawElements(const IndexBuffer& ib, unsigned int instanceCount, unsigned int baseInstance) const;
 };
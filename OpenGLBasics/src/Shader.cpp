@@ -1,57 +1,99 @@
+#include <cstring>
 #include <iostream>
-#include <fstream>
 #include <string>
-#include <sstream>
 
 #include <GL/glew.h>
 
 #include "OpenGLUtil.h"
+#include "CpuProfiler.h"
+#include "GLStateCache.h"
+#include "RedrawTracker.h"
+#include "RenderStats.h"
 #include "Shader.h"
+#include "ShaderCache.h"
+#include "ShaderPreprocessor.h"
+#include "UniformBuffer.h"
 
 using namespace std;
 
-Shader::Shader(const string& filePath)
-    : filePath(filePath),
-    rendererId(0) {
-    
-    ShaderProgramSource source = parseShader("res/shaders/Basic.glsl");
-    cout << "VERTEX SHADER:" << endl;
-    cout << source.vertexSource << endl;
-    cout << "FRAGMENT SHADER:" << endl;
-    cout << source.fragmentSource << endl;
+Shader::Shader(const string& filePath, ShaderCompileMode mode)
+    : Shader(filePath, ShaderPreprocessor::preprocess(filePath).makeSource(vector<string>()), mode) { }
+
+Shader::Shader(const string& name, const ShaderProgramSource& source, ShaderCompileMode mode)
+    : name(name),
+    rendererId(0),
+    ready(false),
+    vertexId(0),
+    fragmentId(0),
+    caching(false),
+    cacheKey(0) {
 
     rendererId = createShader(source.vertexSource, source.fragmentSource);
+    RenderStats::get().onProgramCreated();
+    if (mode == ShaderCompileMode::BLOCKING)
+        finish();
 }
 
 Shader::~Shader() {
+    //NOTE: Deleting shaders (or a program) the driver's still compiling is fine, it just stops caring about the result.
+    if (!ready) {
+        GLCALL(glDeleteShader(vertexId));
+        GLCALL(glDeleteShader(fragmentId));
+    }
     GLCALL(glDeleteProgram(rendererId));
+    GLStateCache::get().onProgramDeleted(rendererId);
+    RenderStats::get().onProgramDeleted();
 }
 
-void Shader::bind() const {
-    GLCALL(glUseProgram(rendererId));
+bool Shader::isReady() const {
+    if (ready)
+        return true;
+    if (isParallelCompileSupported()) {
+        int completed;
+        GLCALL(glGetProgramiv(rendererId, GL_COMPLETION_STATUS_KHR, &completed));
+        if (completed == GL_FALSE)
+            return false;
+    }
+    finishProgram();
+    return true;
 }
 
-void Shader::unbind() const {
-    GLCALL(glUseProgram(0));
+void Shader::finish() const {
+    if (!ready)
+        finishProgram();
+}
+
+bool Shader::isParallelCompileSupported() {
+    return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
 }
 
-void Shader::setUniform4f(const string& parameterName, float v0, float v1, float v2, float v3) {
-    GLCALL(glUniform4f(getUniformLocation(parameterName), v0, v1, v2, v3));
+void Shader::bind() const {
+    finish();
+    GLStateCache::get().useProgram(rendererId);
+}
+
+void Shader::unbind() const {
+    GLStateCache::get().useProgram(0);
 }
 
-int Shader::getUniformLocation(const string& parameterName) {
-    GLCALL(int location = glGetUniformLocation(rendererId, parameterName.c_str()));
-    return location;
+int Shader::getUniformLocation(const string& parameterName) const {
+    int index = findUniform(UniformId(hashUniformName(parameterName.data(), parameterName.size())));
+    return index >= 0 ? uniforms[index].location : -1;
 }
 
-unsigned int Shader::compileShader(unsigned int type, string& source) {
+unsigned int Shader::compileShader(unsigned int type, const string& source) {
+    PROFILE_SCOPE("Shader::compileShader");
     unsigned int id = glCreateShader(type);
     const char* src = source.c_str();
 
     GLCALL(glShaderSource(id, 1, &src, nullptr));
     GLCALL(glCompileShader(id));
 
-    //TODO: Error handling for this shader
+    //NOTE: We don't ask how it went yet (see checkCompiled), since asking waits for the compile to finish.
+    return id;
+}
+
+bool Shader::checkCompiled(unsigned int id) const {
     int result;
 
     //NOTE: iv means int, vector.
@@ -68,61 +110,182 @@ unsigned int Shader::compileShader(unsigned int type, string& source) {
         char* message = (char*) alloca(length * sizeof(char));
 
         GLCALL(glGetShaderInfoLog(id, length, &length, message));
-        cout << "Failed to compile a shader!" << endl;
+        cout << "Failed to compile a shader (" << name << ")!" << endl;
         cout << message << endl;
-
-        GLCALL(glDeleteShader(id));
-        return 0;
+        return false;
     }
-
-    return id;
+    return true;
 }
 
-unsigned int Shader::createShader(string& vertexShader, string& fragmentShader) {
+unsigned int Shader::createShader(const string& vertexShader, const string& fragmentShader) {
+    PROFILE_SCOPE("Shader::createShader");
     unsigned int program = glCreateProgram();
 
-    unsigned int vs = compileShader(GL_VERTEX_SHADER, vertexShader);
-    unsigned int fs = compileShader(GL_FRAGMENT_SHADER, fragmentShader);
+    ShaderCache& cache = ShaderCache::get();
+    caching = cache.isEnabled();
+    cacheKey = caching ? cache.makeKey(vertexShader, fragmentShader) : 0;
+    if (caching) {
+        if (cache.load(cacheKey, program)) {
+            rendererId = program;
+            bindUniformBlocks(program);
+            reflectUniforms();
+            ready = true;
+            return program;
+        }
 
-    GLCALL(glAttachShader(program, vs));
-    GLCALL(glAttachShader(program, fs));
+        //NOTE: Start over with a fresh program, in case the driver left anything behind from a rejected binary.
+        GLCALL(glDeleteProgram(program));
+        program = glCreateProgram();
+        GLCALL(glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
 
-    GLCALL(glLinkProgram(program));
-    GLCALL(glValidateProgram(program));
+    //NOTE: Ask the driver for as many compiler threads as it's willing to use (the default is up to it).
+    static bool threadsRequested = false;
+    if (!threadsRequested && isParallelCompileSupported()) {
+        if (GLEW_KHR_parallel_shader_compile) {
+            GLCALL(glMaxShaderCompilerThreadsKHR(0xFFFFFFFF));
+        } else {
+            GLCALL(glMaxShaderCompilerThreadsARB(0xFFFFFFFF));
+        }
+        threadsRequested = true;
+    }
 
-    GLCALL(glDeleteShader(vs));
-    GLCALL(glDeleteShader(fs));
+    vertexId = compileShader(GL_VERTEX_SHADER, vertexShader);
+    fragmentId = compileShader(GL_FRAGMENT_SHADER, fragmentShader);
 
-    //TODO: Detach shaders after compiling? Maybe covered in a later TheCherno episode (after episode 7)
+    GLCALL(glAttachShader(program, vertexId));
+    GLCALL(glAttachShader(program, fragmentId));
 
+    //NOTE: Linking doesn't wait for the compiles either. It just queues up behind them.
+    GLCALL(glLinkProgram(program));
+
+    //TODO: Detach shaders after compiling? Maybe covered in a later TheCherno episode (after episode 7)
     return program;
 }
 
-ShaderProgramSource Shader::parseShader(const string& filePath) {
-    enum class ShaderType {
-        NONE = -1,
-        VERTEX = 0,
-        FRAGMENT = 1
-    };
-
-    ifstream stream = ifstream(filePath);
-    string line;
-    stringstream ss[2];
-    ShaderType type = ShaderType::NONE;
-
-    while (getline(stream, line)) {
-        if (line.find("#shader") != string::npos) {
-            if (line.find("vertex") != string::npos)
-                type = ShaderType::VERTEX;
-            else if (line.find("fragment") != string::npos)
-                type = ShaderType::FRAGMENT;
-        } else {
-            ss[(int) type] << line << '\n';
+void Shader::finishProgram() const {
+    PROFILE_SCOPE("Shader::finishProgram");
+    bool compiled = checkCompiled(vertexId);
+    compiled = checkCompiled(fragmentId) && compiled;
+
+    int linked;
+    GLCALL(glGetProgramiv(rendererId, GL_LINK_STATUS, &linked));
+    if (linked == GL_FALSE && compiled) {
+        int length;
+        GLCALL(glGetProgramiv(rendererId, GL_INFO_LOG_LENGTH, &length));
+        char* message = (char*) alloca((length + 1) * sizeof(char));
+        message[0] = '\0';
+        GLCALL(glGetProgramInfoLog(rendererId, length + 1, &length, message));
+        cout << "Failed to link a shader program (" << name << ")!" << endl;
+        cout << message << endl;
+    }
+    GLCALL(glValidateProgram(rendererId));
+
+    GLCALL(glDeleteShader(vertexId));
+    GLCALL(glDeleteShader(fragmentId));
+    vertexId = 0;
+    fragmentId = 0;
+
+    bindUniformBlocks(rendererId);
+    if (linked == GL_TRUE)
+        reflectUniforms();
+    if (caching && linked == GL_TRUE)
+        ShaderCache::get().store(cacheKey, rendererId);
+    ready = true;
+}
+
+void Shader::bindUniformBlocks(unsigned int program) const {
+    int blockCount;
+    GLCALL(glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount));
+
+    for (int i = 0; i < blockCount; i++) {
+        char name[256];
+        GLCALL(glGetActiveUniformBlockName(program, i, sizeof(name), nullptr, name));
+        GLCALL(glUniformBlockBinding(program, i, UniformBuffer::getBindingPoint(name)));
+    }
+}
+
+void Shader::reflectUniforms() const {
+    uniforms.clear();
+    uniformShadow.clear();
+
+    int uniformCount;
+    int maxNameLength;
+    GLCALL(glGetProgramiv(rendererId, GL_ACTIVE_UNIFORMS, &uniformCount));
+    GLCALL(glGetProgramiv(rendererId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength));
+    vector<char> name(maxNameLength + 1);
+
+    for (int i = 0; i < uniformCount; i++) {
+        int count;
+        GLenum type;
+        name[0] = '\0';
+        GLCALL(glGetActiveUniform(rendererId, i, (GLsizei) name.size(), nullptr, &count, &type, name.data()));
+
+        //NOTE: Uniforms in a block are active too, but they're set through a UniformBuffer, and have no location.
+        GLCALL(int location = glGetUniformLocation(rendererId, name.data()));
+        if (location == -1)
+            continue;
+
+        ShaderUniform uniform;
+        uniform.name = name.data();
+
+        //NOTE: Arrays of basic types come back as their first element ("u_Textures[0]"), so that's the only suffix we strip.
+        //      Members of an array of structs come back one by one ("lights[1].color"), and each is a uniform of its own.
+        static const string ARRAY_SUFFIX = "[0]";
+        if (uniform.name.size() > ARRAY_SUFFIX.size() && uniform.name.compare(uniform.name.size() - ARRAY_SUFFIX.size(), ARRAY_SUFFIX.size(), ARRAY_SUFFIX) == 0)
+            uniform.name.erase(uniform.name.size() - ARRAY_SUFFIX.size());
+        uniform.nameHash = hashUniformName(uniform.name.data(), uniform.name.size());
+        uniform.location = location;
+        uniform.type = type;
+        uniform.count = count;
+        uniform.shadowOffset = (unsigned int) uniformShadow.size();
+        uniform.elementSize = 0;
+        uniform.knownCount = 0;
+        for (const ShaderUniform& other : uniforms) {
+            if (other.nameHash == uniform.nameHash) {
+                cout << "Uniforms " << other.name << " and " << uniform.name << " in " << this->name << " have the same UniformId hash! Rename one of them." << endl;
+                ASSERT(false);
+            }
         }
+        uniforms.push_back(uniform);
+
+        //NOTE: The biggest type we upload is a dmat4, so that's how much room each element gets (until its first upload tells us better).
+        uniformShadow.resize(uniformShadow.size() + count * sizeof(DMat4));
+    }
+}
+
+int Shader::findUniform(UniformId id) const {
+    finish();
+    for (size_t i = 0; i < uniforms.size(); i++) {
+        if (uniforms[i].nameHash == id.hash)
+            return (int) i;
+    }
+    return -1;
+}
+
+void Shader::reportTypeMismatch(int index) const {
+    cout << "Uniform " << uniforms[index].name << " in " << name << " can't be set with that type (its GL type is 0x" << std::hex << uniforms[index].type << std::dec << ")!" << endl;
+    ASSERT(false);
+}
+
+bool Shader::updateShadow(int index, const void* values, int count, unsigned int elementSize) {
+    ShaderUniform& uniform = uniforms[index];
+    count = std::min(count, uniform.count);
+    size_t size = (size_t) count * elementSize;
+    unsigned char* shadow = &uniformShadow[uniform.shadowOffset];
+
+    //NOTE: A handle's type is checked against the uniform's, so the element size only changes between types that upload the same way (int and bool, say).
+    if (uniform.elementSize == elementSize && count <= uniform.knownCount && memcmp(shadow, values, size) == 0) {
+        RenderStats::get().onUniformSkipped();
+        return false;
     }
+    if (uniform.elementSize != elementSize)
+        uniform.knownCount = 0;
+    memcpy(shadow, values, size);
+    uniform.elementSize = elementSize;
+    uniform.knownCount = std::max(uniform.knownCount, count);
 
-    return ShaderProgramSource{
-        ss[(int) ShaderType::VERTEX].str(),
-        ss[(int) ShaderType::FRAGMENT].str()
-    };
+    RenderStats::get().onUniformUpload();
+    RedrawTracker::get().invalidate();
+    return true;
 }
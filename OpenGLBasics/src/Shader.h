@@ -1,31 +1,149 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+#include "UniformId.h"
+#include "UniformTypes.h"
 
 using std::string;
+using std::vector;
 
 struct ShaderProgramSource {
     string vertexSource;
     string fragmentSource;
 };
 
+enum class ShaderCompileMode {
+    BLOCKING,   //Compiled and linked by the time the constructor returns
+    ASYNC       //Only started by the constructor. Check isReady() before drawing with it, or binding it will wait for it.
+};
+
+//One entry of a Shader's uniform table, reflected once it's linked
+struct ShaderUniform {
+    string name;            //Without the "[0]" an array's name ends with. Struct members keep their full name, like "lights[1].color"
+    uint32_t nameHash;      //Its UniformId
+    int location;
+    unsigned int type;      //GL_FLOAT_VEC4, GL_SAMPLER_2D...
+    int count;              //How many elements, if it's an array, or 1
+    unsigned int shadowOffset; //Where its last uploaded value is kept in Shader::uniformShadow
+    unsigned int elementSize;
+    int knownCount;         //How many of its elements we know the value of (uploaded ourselves), from the first
+};
+
+//NOTE: Async shaders have their compiles and link kicked off all at once, and we don't ask for the result until isReady(),
+//      so the driver can work on them (with GL_KHR_parallel_shader_compile, on its own threads) while we load everything else.
+//      With the extension, isReady() doesn't block, and Renderer skips (or substitutes) draws with shaders that aren't ready yet.
+//      Without it, there's no way to ask without waiting, so the first isReady() finishes the shader, however long that takes.
 class Shader {
     private:
-    string filePath;
+    string name;    //Where it came from (its file path, for one loaded from a file), for logging
     unsigned int rendererId;
 
+    //Until the program's finished (see finishProgram), the shaders we're still linking, and whether we'll cache the result
+    mutable bool ready;
+    mutable unsigned int vertexId;
+    mutable unsigned int fragmentId;
+    bool caching;
+    uint64_t cacheKey;
+
+    //Every active uniform outside of a uniform block, and a copy of the values we last uploaded to them, so we can skip uploading the same ones again
+    mutable vector<ShaderUniform> uniforms;
+    mutable vector<unsigned char> uniformShadow;
+
     public:
-    Shader(const string& fileName);
+    /// <summary>
+    /// Loads a shader file (see ShaderPreprocessor), compiling its default permutation if it declares any variants (see ShaderVariants for the others).
+    /// </summary>
+    Shader(const string& filePath, ShaderCompileMode mode = ShaderCompileMode::BLOCKING);
+    Shader(const string& name, const ShaderProgramSource& source, ShaderCompileMode mode = ShaderCompileMode::BLOCKING);
     ~Shader();
 
+    //NOTE: Owns its program, so no copies.
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    inline unsigned int getRendererId() const { return rendererId; }
+
+    /// <summary>
+    /// Whether the program's done compiling and linking (successfully or not), so using it won't wait on the driver.
+    /// </summary>
+    bool isReady() const;
+
+    //Waits for the program to be done compiling and linking
+    void finish() const;
+
+    //Whether the driver can compile shaders in the background and tell us when it's done without blocking (GL_KHR_parallel_shader_compile)
+    static bool isParallelCompileSupported();
+
     void bind() const;
     void unbind() const;
 
-    void setUniform4f(const string& parameterName, float f0, float f1, float f2, float f3);
+    /// <summary>
+    /// Looks up an active uniform (like "u_Color"_u, or "u_Textures"_u for an array), checking that T can be uploaded to its type.
+    /// </summary>
+    //NOTE: Waits for the shader to be ready. Looking up means searching the uniform table (comparing hashes), so anything set often should keep its handle.
+    template <typename T>
+    UniformHandle<T> getUniform(UniformId id) const {
+        int index = findUniform(id);
+        if (index >= 0 && !UniformType<T>::matches(uniforms[index].type)) {
+            reportTypeMismatch(index);
+            return UniformHandle<T>();
+        }
+        return UniformHandle<T>(index);
+    }
+
+    //For names only known at runtime
+    template <typename T>
+    inline UniformHandle<T> getUniform(const string& name) const { return getUniform<T>(UniformId(hashUniformName(name.data(), name.size()))); }
+
+    /// <summary>
+    /// Uploads values to the uniform (which must be bound), unless they're what we last uploaded to it. For arrays, sets the first count elements.
+    /// </summary>
+    template <typename T>
+    void setUniform(UniformHandle<T> uniform, const T* values, int count = 1) {
+        if (uniform.isValid() && updateShadow(uniform.index, values, count, sizeof(T)))
+            UniformType<T>::upload(uniforms[uniform.index].location, std::min(count, uniforms[uniform.index].count), values);
+    }
+
+    template <typename T>
+    inline void setUniform(UniformHandle<T> uniform, const T& value) { setUniform(uniform, &value, 1); }
+
+    /// <summary>
+    /// Looks the uniform up and sets it, like shader.set("u_Color"_u, Vec4{ 1, 0, 0, 1 }). No strings and no allocations, but keeping a handle still saves the lookup.
+    /// </summary>
+    template <typename T>
+    inline void set(UniformId id, const T* values, int count) { setUniform(getUniform<T>(id), values, count); }
+
+    template <typename T>
+    inline void set(UniformId id, const T& value) { setUniform(getUniform<T>(id), &value, 1); }
+
+    inline const vector<ShaderUniform>& getUniforms() const { return uniforms; }
+
+    //-1 if there's no such active uniform
+    int getUniformLocation(const string& parameterName) const;
 
     private:
-    int getUniformLocation(const string& parameterName);
-    unsigned int compileShader(unsigned int type, string& source);
-    unsigned int createShader(string& vertexShader, string& fragmentShader);
-    ShaderProgramSource parseShader(const string& filePath);
+    unsigned int compileShader(unsigned int type, const string& source);
+    bool checkCompiled(unsigned int id) const;
+
+    //Starts compiling and linking (unless the program's in the ShaderCache), without waiting for any of it.
+    unsigned int createShader(const string& vertexShader, const string& fragmentShader);
+
+    //Waits for (and checks) whatever createShader started.
+    void finishProgram() const;
+
+    //Points each uniform block the program declares at the binding point UniformBuffer uses for that block name.
+    void bindUniformBlocks(unsigned int program) const;
+
+    //Fills in the uniform table, once the program's linked
+    void reflectUniforms() const;
+
+    int findUniform(UniformId id) const;
+    void reportTypeMismatch(int index) const;
+
+    //Stores values as the uniform's last uploaded value, and returns whether it's any different from before (so it needs uploading).
+    bool updateShadow(int index, const void* values, int count, unsigned int elementSize);
 };
@@ -0,0 +1,194 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <GL/glew.h>
+
+#include "OpenGLUtil.h"
+#include "CpuProfiler.h"
+#include "GLTrace.h"
+#include "ShaderCache.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+//Starts every cache file, so we never try to load something else (or an older layout) as a program binary.
+static const uint32_t CACHE_FILE_MAGIC = 0x42504C47; //"GLPB", little-endian
+static const uint32_t CACHE_FILE_VERSION = 1;
+
+struct CacheFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;           //Checked again on load, in case two keys ever end up with the same file name
+    uint32_t binaryFormat;
+    uint32_t binarySize;
+};
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+//64-bit FNV-1a, continuing from hash
+static uint64_t hashBytes(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS) {
+    const unsigned char* bytes = (const unsigned char*) data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+//NOTE: Includes the terminating '\0', so "ab" + "c" and "a" + "bc" hash differently.
+static uint64_t hashString(const string& text, uint64_t hash) {
+    return hashBytes(text.c_str(), text.size() + 1, hash);
+}
+
+static string getGLString(GLenum name) {
+    GLCALL(const GLubyte* value = glGetString(name));
+    return value != nullptr ? string((const char*) value) : string();
+}
+
+ShaderCache& ShaderCache::get() {
+    static ShaderCache cache;
+    return cache;
+}
+
+ShaderCache::ShaderCache()
+    : checked(false),
+    supported(false),
+    driverHash(0),
+    hits(0),
+    misses(0),
+    rejected(0) { }
+
+void ShaderCache::setDirectory(const string& directory) {
+    this->directory = directory;
+    if (directory.empty())
+        return;
+
+    //NOTE: Fails harmlessly when it already exists. If it really can't be made, storing will just fail (and say so).
+#ifdef _WIN32
+    _mkdir(directory.c_str());
+#else
+    mkdir(directory.c_str(), 0755);
+#endif
+}
+
+bool ShaderCache::isEnabled() {
+    if (directory.empty() || GLTrace::isCapturing())
+        return false;
+
+    if (!checked) {
+        checked = true;
+        if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+            int formatCount = 0;
+            GLCALL(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+            supported = formatCount > 0;
+        }
+        if (!supported)
+            cout << "This driver can't save program binaries, so the shader cache is off." << endl;
+
+        driverHash = hashString(getGLString(GL_VENDOR), FNV_OFFSET_BASIS);
+        driverHash = hashString(getGLString(GL_RENDERER), driverHash);
+        driverHash = hashString(getGLString(GL_VERSION), driverHash);
+    }
+    return supported;
+}
+
+uint64_t ShaderCache::makeKey(const string& vertexSource, const string& fragmentSource) {
+    uint64_t key = hashBytes(&driverHash, sizeof(driverHash));
+    key = hashString(vertexSource, key);
+    return hashString(fragmentSource, key);
+}
+
+bool ShaderCache::load(uint64_t key, unsigned int program) {
+    PROFILE_SCOPE("ShaderCache::load");
+    std::ifstream stream = std::ifstream(getFilePath(key), std::ios::binary | std::ios::ate);
+    std::streamoff fileSize = stream ? (std::streamoff) stream.tellg() : 0;
+    stream.seekg(0);
+    CacheFileHeader header;
+    if (!stream || !stream.read((char*) &header, sizeof(header)) || header.magic != CACHE_FILE_MAGIC
+        || header.version != CACHE_FILE_VERSION || header.key != key) {
+        misses++;
+        return false;
+    }
+
+    //NOTE: Checked before we allocate for it, so a corrupt size can't have us allocating gigabytes.
+    if (header.binarySize != fileSize - (std::streamoff) sizeof(header)) {
+        cout << "A shader cache file is corrupt (its size doesn't match its header), so we'll compile it again." << endl;
+        misses++;
+        return false;
+    }
+
+    vector<char> binary(header.binarySize);
+    if (!stream.read(binary.data(), binary.size())) {
+        misses++;
+        return false;
+    }
+
+    //NOTE: Not GLCALL'd, since a rejected binary is expected every now and then, and isn't an error on our part.
+    glProgramBinary(program, header.binaryFormat, binary.data(), (GLsizei) binary.size());
+    int linked = GL_FALSE;
+    GLCALL(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+    if (linked == GL_FALSE) {
+        cout << "The driver rejected a cached program binary, so we'll compile it again." << endl;
+        rejected++;
+        return false;
+    }
+    hits++;
+    return true;
+}
+
+void ShaderCache::store(uint64_t key, unsigned int program) {
+    PROFILE_SCOPE("ShaderCache::store");
+    int size = 0;
+    GLCALL(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size));
+    if (size <= 0)
+        return;
+
+    vector<char> binary(size);
+    GLenum format = 0;
+    GLCALL(glGetProgramBinary(program, size, &size, &format, binary.data()));
+
+    //NOTE: Written to a temporary file, then renamed over the real one, so another instance starting up at the same time never reads half a file.
+    //      The temporary file's name has our process ID in it, so two instances storing the same program can't write into the same one.
+    string filePath = getFilePath(key);
+    string tempPath = filePath + "." + std::to_string((long long) getpid()) + ".tmp";
+    {
+        std::ofstream stream = std::ofstream(tempPath, std::ios::binary);
+        CacheFileHeader header = { CACHE_FILE_MAGIC, CACHE_FILE_VERSION, key, format, (uint32_t) size };
+        if (!stream || !stream.write((const char*) &header, sizeof(header)) || !stream.write(binary.data(), size)) {
+            cout << "Failed to write " << tempPath << "!" << endl;
+            stream.close();
+            std::remove(tempPath.c_str());
+            return;
+        }
+    }
+    std::remove(filePath.c_str()); //Windows won't rename over an existing file
+    if (std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+        cout << "Failed to write " << filePath << "!" << endl;
+        std::remove(tempPath.c_str());
+    }
+}
+
+void ShaderCache::print() const {
+    if (directory.empty() || !supported)
+        return;
+    cout << "Shader cache: loaded " << hits << " programs, compiled " << (misses + rejected) << " (" << rejected << " of them rejected by the driver)." << endl;
+}
+
+string ShaderCache::getFilePath(uint64_t key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long) key);
+    return directory + "/" + name;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+using std::string;
+
+/// <summary>
+/// Saves linked programs to disk (with glGetProgramBinary), so later runs can load them back (with glProgramBinary) instead of compiling and linking again.
+/// </summary>
+//NOTE: Programs are keyed by a hash of their (already parsed) sources, plus the driver's vendor, renderer and version strings,
+//      since a binary is only good for the exact driver that made it. The driver can still reject a binary (after an update it doesn't
+//      admit to in its version string, say), so Shader always falls back to compiling, then replaces the cached binary.
+//      Needs OpenGL 4.1 or ARB_get_program_binary, and a driver offering at least one binary format. Otherwise, or without a directory, it stays off.
+//      Also off while capturing (see GLTrace), so captures compile from source and can be replayed on any driver.
+//      Like RenderStats, there's just one (see get()).
+class ShaderCache {
+    private:
+    string directory;
+    bool checked;   //Whether we've asked the driver if it supports program binaries yet
+    bool supported;
+    uint64_t driverHash;
+
+    unsigned int hits;
+    unsigned int misses;
+    unsigned int rejected;
+
+    public:
+    static ShaderCache& get();
+
+    ShaderCache();
+
+    /// <summary>
+    /// Where to keep program binaries (made if it doesn't exist), or "" to turn the cache off. Set this before creating any Shaders.
+    /// </summary>
+    void setDirectory(const string& directory);
+
+    //NOTE: Needs a current context.
+    bool isEnabled();
+
+    uint64_t makeKey(const string& vertexSource, const string& fragmentSource);
+
+    /// <summary>
+    /// Loads the cached binary for key into program, if there is one and the driver accepts it. Otherwise, program is left unlinked, to be compiled as usual.
+    /// </summary>
+    bool load(uint64_t key, unsigned int program);
+
+    /// <summary>
+    /// Saves a linked program's binary for key. The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+    /// </summary>
+    void store(uint64_t key, unsigned int program);
+
+    void print() const;
+
+    private:
+    string getFilePath(uint64_t key) const;
+};
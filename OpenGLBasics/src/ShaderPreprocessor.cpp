@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "CpuProfiler.h"
+#include "ShaderPreprocessor.h"
+
+using std::cout;
+using std::endl;
+
+unordered_map<string, string> ShaderPreprocessor::fileCache;
+
+enum class ShaderStage {
+    NONE = -1,
+    VERTEX = 0,
+    FRAGMENT = 1
+};
+
+struct ShaderPreprocessor::State {
+    ShaderStage stage;
+    std::stringstream stages[2];
+    vector<string> includedFiles[2]; //Per stage, so each one gets its own copy of a shared include
+    bool versionWritten[2];          //#line can't come before #version
+    bool needsLine[2];               //Whether the next line written to each stage isn't the one after the last, so it needs a #line
+    PreprocessedShader result;
+};
+
+//Everything before the last slash, including it (or "" if there isn't one)
+static string getDirectory(const string& filePath) {
+    size_t slash = filePath.find_last_of("/\\");
+    return slash == string::npos ? string() : filePath.substr(0, slash + 1);
+}
+
+//The same file always gets the same path, with forward slashes, and no "." or "dir/.." in it.
+static string normalizePath(const string& filePath) {
+    vector<string> parts;
+    size_t start = 0;
+    while (start <= filePath.size()) {
+        size_t end = filePath.find_first_of("/\\", start);
+        if (end == string::npos)
+            end = filePath.size();
+        string part = filePath.substr(start, end - start);
+        if (part == ".." && !parts.empty() && parts.back() != "..")
+            parts.pop_back();
+        else if (!part.empty() && part != ".")
+            parts.push_back(part);
+        start = end + 1;
+    }
+
+    string normalized = !filePath.empty() && (filePath[0] == '/' || filePath[0] == '\\') ? "/" : "";
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (i > 0)
+            normalized += '/';
+        normalized += parts[i];
+    }
+    return normalized;
+}
+
+//Whether line is the directive (after any indentation), and if so, where what comes after it starts
+static bool matchDirective(const string& line, const char* directive, size_t& rest) {
+    size_t start = line.find_first_not_of(" \t");
+    if (start == string::npos || line.compare(start, strlen(directive), directive) != 0)
+        return false;
+    rest = start + strlen(directive);
+    return true;
+}
+
+//Inserts each #define right after the #version line (which has to come first), or at the very top if there isn't one.
+static string addDefines(const string& source, const string& defines) {
+    if (defines.empty())
+        return source;
+    size_t version = source.find("#version");
+    if (version == string::npos)
+        return defines + source;
+    size_t lineEnd = source.find('\n', version);
+    if (lineEnd == string::npos)
+        return source + "\n" + defines;
+    return source.substr(0, lineEnd + 1) + defines + source.substr(lineEnd + 1);
+}
+
+ShaderProgramSource PreprocessedShader::makeSource(const vector<string>& keywords) const {
+    string defines;
+    for (const VariantGroup& group : variantGroups) {
+        const string* defined = nullptr;
+        for (const string& keyword : group.keywords) {
+            if (std::find(keywords.begin(), keywords.end(), keyword) != keywords.end()) {
+                defined = &keyword;
+                break;
+            }
+        }
+        if (defined == nullptr && !group.isBoolean())
+            defined = &group.keywords[0];
+        if (defined != nullptr)
+            defines += "#define " + *defined + "\n";
+    }
+    return ShaderProgramSource{
+        addDefines(source.vertexSource, defines),
+        addDefines(source.fragmentSource, defines)
+    };
+}
+
+PreprocessedShader ShaderPreprocessor::preprocess(const string& filePath) {
+    PROFILE_SCOPE("ShaderPreprocessor::preprocess");
+    State state;
+    state.stage = ShaderStage::NONE;
+    for (int i = 0; i < 2; i++)
+        state.versionWritten[i] = state.needsLine[i] = false;
+    processFile(normalizePath(filePath), state);
+
+    state.result.source = ShaderProgramSource{
+        state.stages[(int) ShaderStage::VERTEX].str(),
+        state.stages[(int) ShaderStage::FRAGMENT].str()
+    };
+    return state.result;
+}
+
+void ShaderPreprocessor::clearCache() {
+    fileCache.clear();
+}
+
+const string* ShaderPreprocessor::readFile(const string& filePath) {
+    unordered_map<string, string>::const_iterator cached = fileCache.find(filePath);
+    if (cached != fileCache.end())
+        return &cached->second;
+
+    std::ifstream stream = std::ifstream(filePath);
+    if (!stream) {
+        cout << "Failed to open shader file " << filePath << "!" << endl;
+        return nullptr;
+    }
+    std::stringstream contents;
+    contents << stream.rdbuf();
+    return &(fileCache[filePath] = contents.str());
+}
+
+void ShaderPreprocessor::processFile(const string& filePath, State& state) {
+    const string* contents = readFile(filePath);
+    if (contents == nullptr)
+        return;
+
+    vector<string>& sourceFiles = state.result.sourceFiles;
+    int fileIndex = (int) (std::find(sourceFiles.begin(), sourceFiles.end(), filePath) - sourceFiles.begin());
+    if (fileIndex == (int) sourceFiles.size())
+        sourceFiles.push_back(filePath);
+    state.needsLine[0] = state.needsLine[1] = true;
+
+    std::istringstream stream = std::istringstream(*contents);
+    string line;
+    size_t rest;
+    int lineNumber = 0;
+    while (getline(stream, line)) {
+        lineNumber++;
+        if (matchDirective(line, "#shader", rest)) {
+            if (line.find("vertex", rest) != string::npos)
+                state.stage = ShaderStage::VERTEX;
+            else if (line.find("fragment", rest) != string::npos)
+                state.stage = ShaderStage::FRAGMENT;
+            state.needsLine[0] = state.needsLine[1] = true;
+        } else if (matchDirective(line, "#pragma variant", rest)) {
+            declareVariant(line.substr(rest), state);
+            state.needsLine[0] = state.needsLine[1] = true;
+        } else if (state.stage == ShaderStage::NONE) {
+            continue; //Not in any stage yet, so there's nowhere for it to go
+        } else if (matchDirective(line, "#include", rest)) {
+            size_t open = line.find('"', rest);
+            size_t close = open == string::npos ? string::npos : line.find('"', open + 1);
+            if (close == string::npos) {
+                cout << filePath << ": expected #include \"path\", but got: " << line << endl;
+                continue;
+            }
+            string includePath = normalizePath(getDirectory(filePath) + line.substr(open + 1, close - open - 1));
+
+            //NOTE: Even if we skip it, that's still a line missing from the output.
+            state.needsLine[0] = state.needsLine[1] = true;
+            vector<string>& included = state.includedFiles[(int) state.stage];
+            if (std::find(included.begin(), included.end(), includePath) != included.end())
+                continue;
+            included.push_back(includePath);
+            processFile(includePath, state);
+            state.needsLine[0] = state.needsLine[1] = true;
+        } else {
+            int stage = (int) state.stage;
+            if (state.needsLine[stage] && state.versionWritten[stage]) {
+                state.stages[stage] << "#line " << lineNumber << ' ' << fileIndex << '\n';
+                state.needsLine[stage] = false;
+            }
+            state.stages[stage] << line << '\n';
+
+            //NOTE: makeSource() puts its #defines right after #version, so whatever comes next needs a #line either way.
+            if (matchDirective(line, "#version", rest))
+                state.versionWritten[stage] = state.needsLine[stage] = true;
+        }
+    }
+}
+
+void ShaderPreprocessor::declareVariant(const string& declaration, State& state) {
+    VariantGroup group;
+    std::istringstream stream = std::istringstream(declaration);
+    string keyword;
+    while (stream >> keyword)
+        group.keywords.push_back(keyword);
+    if (group.keywords.empty())
+        return;
+
+    //NOTE: Both stages (or several includes) can declare the same group, but it's still just one group.
+    for (const VariantGroup& existing : state.result.variantGroups) {
+        if (existing.keywords == group.keywords)
+            return;
+    }
+    state.result.variantGroups.push_back(group);
+}
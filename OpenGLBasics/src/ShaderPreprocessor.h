@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.h"
+
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+/// <summary>
+/// Keywords declared with "#pragma variant" that a shader can be compiled with (each as a #define), to get a permutation of it.
+/// One keyword is a boolean (defined or not). More than one are an enum: exactly one of them is always defined, the first by default.
+/// </summary>
+struct VariantGroup {
+    vector<string> keywords;
+
+    inline bool isBoolean() const { return keywords.size() == 1; }
+};
+
+/// <summary>
+/// A shader file with its includes resolved, and its variants found, ready to make the source for any of its permutations.
+/// </summary>
+struct PreprocessedShader {
+    ShaderProgramSource source;
+    vector<VariantGroup> variantGroups;
+
+    //The file each source string number in the #line directives stands for, so "1(12)" in a compile error means line 12 of sourceFiles[1]
+    vector<string> sourceFiles;
+
+    /// <summary>
+    /// The source with each of keywords #defined (right after #version), plus the first keyword of every enum group that has none of its keywords in there.
+    /// </summary>
+    ShaderProgramSource makeSource(const vector<string>& keywords) const;
+};
+
+/// <summary>
+/// Turns one of our .glsl files into the source for each stage. Besides the "#shader vertex" and "#shader fragment" markers, it understands:
+///     #include "path"                 Pastes in another file (relative to this one), at most once per stage, no matter how many times (or by which path) it's included.
+///     #pragma variant KEYWORD         Declares a boolean keyword (see VariantGroup).
+///     #pragma variant ONE TWO THREE   Declares an enum of keywords.
+/// </summary>
+//NOTE: Included files are read from disk just once for as long as we run, since many shaders tend to share the same few.
+//      Each stage gets #line directives wherever it switches files, so compile errors still point at the right line (see PreprocessedShader::sourceFiles).
+class ShaderPreprocessor {
+    private:
+    static unordered_map<string, string> fileCache;
+
+    public:
+    static PreprocessedShader preprocess(const string& filePath);
+
+    //Forgets every file we've read, so changes on disk get picked up (e.g. for hot reloading)
+    static void clearCache();
+
+    private:
+    struct State;
+
+    //NOTE: Null if the file couldn't be read.
+    static const string* readFile(const string& filePath);
+    static void processFile(const string& filePath, State& state);
+    static void declareVariant(const string& declaration, State& state);
+};
@@ -0,0 +1,80 @@
+#include <iostream>
+
+#include "OpenGLUtil.h"
+#include "ShaderVariants.h"
+
+using std::cout;
+using std::endl;
+
+//How many bits it takes to tell a group's options apart. A boolean's on or off, and an enum's one of its keywords.
+static unsigned int getGroupBits(const VariantGroup& group) {
+    size_t options = group.isBoolean() ? 2 : group.keywords.size();
+    unsigned int bits = 0;
+    while (((size_t) 1 << bits) < options)
+        bits++;
+    return bits;
+}
+
+ShaderVariants::ShaderVariants(const string& filePath)
+    : filePath(filePath),
+    preprocessed(ShaderPreprocessor::preprocess(filePath)) {
+    unsigned int shift = 0;
+    for (const VariantGroup& group : preprocessed.variantGroups) {
+        groupShifts.push_back(shift);
+        shift += getGroupBits(group);
+    }
+    ASSERT(shift <= 64);
+}
+
+ShaderVariants::Key ShaderVariants::makeKey(const vector<string>& keywords) const {
+    Key key = 0;
+    for (const string& keyword : keywords) {
+        bool found = false;
+        for (size_t i = 0; i < preprocessed.variantGroups.size() && !found; i++) {
+            const VariantGroup& group = preprocessed.variantGroups[i];
+            for (size_t j = 0; j < group.keywords.size(); j++) {
+                if (group.keywords[j] != keyword)
+                    continue;
+                //A boolean's bit is 1 when it's on, and an enum's bits are which of its keywords is on.
+                Key value = group.isBoolean() ? 1 : (Key) j;
+                Key mask = (((Key) 1 << getGroupBits(group)) - 1) << groupShifts[i];
+                key = (key & ~mask) | (value << groupShifts[i]);
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            cout << filePath << " has no variant keyword " << keyword << ", ignoring it." << endl;
+    }
+    return key;
+}
+
+Shader& ShaderVariants::get(Key key) {
+    unordered_map<Key, unique_ptr<Shader>>::const_iterator found = compiled.find(key);
+    if (found != compiled.end())
+        return *found->second;
+
+    vector<string> keywords = getKeywords(key);
+    string name = filePath;
+    for (const string& keyword : keywords)
+        name += " " + keyword;
+
+    Shader* shader = new Shader(name, preprocessed.makeSource(keywords));
+    compiled[key] = unique_ptr<Shader>(shader);
+    return *shader;
+}
+
+vector<string> ShaderVariants::getKeywords(Key key) const {
+    vector<string> keywords;
+    for (size_t i = 0; i < preprocessed.variantGroups.size(); i++) {
+        const VariantGroup& group = preprocessed.variantGroups[i];
+        Key value = (key >> groupShifts[i]) & (((Key) 1 << getGroupBits(group)) - 1);
+        if (group.isBoolean()) {
+            if (value != 0)
+                keywords.push_back(group.keywords[0]);
+        } else if (value < group.keywords.size()) {
+            keywords.push_back(group.keywords[(size_t) value]);
+        }
+    }
+    return keywords;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.h"
+#include "ShaderPreprocessor.h"
+
+using std::string;
+using std::unique_ptr;
+using std::unordered_map;
+using std::vector;
+
+/// <summary>
+/// Every permutation of one shader file (see "#pragma variant" in ShaderPreprocessor), compiled lazily: a permutation is only compiled
+/// the first time it's asked for, then kept. So one file can replace a pile of near-copies, and we only ever compile what we actually draw with.
+/// </summary>
+//NOTE: Permutations are looked up by a Key, which packs which keyword of each VariantGroup is on into a few bits.
+//      Turning keyword names into a Key means searching through them, so do it once up front with makeKey(), and keep the key.
+//      Key 0 is the default permutation: every boolean off, and the first keyword of every enum.
+class ShaderVariants {
+    public:
+    typedef uint64_t Key;
+
+    private:
+    string filePath;
+    PreprocessedShader preprocessed;
+    vector<unsigned int> groupShifts; //Where each group's bits start in a Key
+    unordered_map<Key, unique_ptr<Shader>> compiled;
+
+    public:
+    ShaderVariants(const string& filePath);
+
+    //NOTE: Owns its Shaders, so no copies.
+    ShaderVariants(const ShaderVariants&) = delete;
+    ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+    /// <summary>
+    /// The key for the permutation with these keywords on. Keywords this shader doesn't declare are ignored (with a warning).
+    /// </summary>
+    Key makeKey(const vector<string>& keywords) const;
+
+    /// <summary>
+    /// The permutation for key, compiling it first if this is the first time it's been asked for.
+    /// </summary>
+    //NOTE: Needs a current context. The Shader stays alive (at the same address) for as long as we do.
+    Shader& get(Key key = 0);
+
+    inline bool isCompiled(Key key) const { return compiled.find(key) != compiled.end(); }
+    inline size_t getCompiledCount() const { return compiled.size(); }
+    inline const vector<VariantGroup>& getVariantGroups() const { return preprocessed.variantGroups; }
+
+    private:
+    vector<string> getKeywords(Key key) const;
+};
@@ -0,0 +1,89 @@
+#include <cstring>
+
+#include "SoftwareBackend.h"
+
+SoftwareBackend::SoftwareBackend(int width, int height, unsigned int threadCount)
+    : rasterizer(width, height, threadCount),
+    nextId(1),
+    uniforms() { }
+
+BufferHandle SoftwareBackend::createBuffer(BufferType type, const void* data, unsigned int size) {
+    Buffer buffer;
+    buffer.type = type;
+    buffer.data.resize(size);
+    if (data != nullptr)
+        memcpy(buffer.data.data(), data, size);
+
+    BufferHandle handle = { nextId++ };
+    buffers[handle.id] = std::move(buffer);
+    return handle;
+}
+
+void SoftwareBackend::updateBuffer(BufferHandle buffer, const void* data, unsigned int size, unsigned int offset) {
+    Buffer& existing = buffers.at(buffer.id);
+    ASSERT(existing.type == BufferType::VERTEX && offset + size <= existing.data.size());
+    memcpy(existing.data.data() + offset, data, size);
+}
+
+void SoftwareBackend::destroyBuffer(BufferHandle buffer) {
+    buffers.erase(buffer.id);
+}
+
+PipelineHandle SoftwareBackend::createPipeline(const PipelineDesc& desc) {
+    ASSERT(desc.softwareShader != nullptr);
+    Pipeline pipeline = { desc.softwareShader, desc.layout };
+
+    PipelineHandle handle = { nextId++ };
+    pipelines[handle.id] = pipeline;
+    return handle;
+}
+
+void SoftwareBackend::destroyPipeline(PipelineHandle pipeline) {
+    pipelines.erase(pipeline.id);
+}
+
+//NOTE: There's nothing to look up ahead of time (a draw is already just a few map lookups), so a command list is just a copy of the draws.
+CommandListHandle SoftwareBackend::recordCommands(const vector<DrawCommand>& draws) {
+    CommandListHandle handle = { nextId++ };
+    commandLists[handle.id] = draws;
+    return handle;
+}
+
+void SoftwareBackend::destroyCommands(CommandListHandle commands) {
+    commandLists.erase(commands.id);
+}
+
+void SoftwareBackend::beginFrame(float r, float g, float b, float a) {
+    rasterizer.clear(r, g, b, a);
+}
+
+void SoftwareBackend::setFrameConstants(const float constants[BACKEND_CONSTANT_COUNT][4]) {
+    memcpy(uniforms, constants, BACKEND_CONSTANT_COUNT * 4 * sizeof(float));
+}
+
+void SoftwareBackend::submit(CommandListHandle commands) {
+    for (const DrawCommand& command : commandLists.at(commands.id))
+        draw(command);
+}
+
+void SoftwareBackend::draw(const DrawCommand& command) {
+    const Pipeline& pipeline = pipelines.at(command.pipeline.id);
+    const Buffer& vertices = buffers.at(command.vertexBuffer.id);
+    const Buffer& indices = buffers.at(command.indexBuffer.id);
+    ASSERT(vertices.type == BufferType::VERTEX && indices.type == BufferType::INDEX);
+    ASSERT((command.firstIndex + command.indexCount) * sizeof(unsigned int) <= indices.data.size());
+
+    memcpy(&uniforms[BACKEND_CONSTANT_COUNT * 4], command.constants, sizeof(command.constants));
+
+    unsigned int vertexCount = (unsigned int) (vertices.data.size() / pipeline.layout.getStride());
+    rasterizer.draw(vertices.data.data(), vertexCount, pipeline.layout, (const unsigned int*) indices.data.data() + command.firstIndex, command.indexCount,
+        *pipeline.shader, uniforms, UNIFORM_COUNT);
+}
+
+void SoftwareBackend::endFrame() {
+    rasterizer.flush();
+}
+
+void SoftwareBackend::readPixels(vector<unsigned char>& pixels) {
+    rasterizer.readPixels(pixels);
+}
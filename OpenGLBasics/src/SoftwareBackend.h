@@ -0,0 +1,63 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "RenderBackend.h"
+#include "SoftwareRasterizer.h"
+
+/// <summary>
+/// The RenderBackend for the <see cref="SoftwareRasterizer"/>, so everything drawn through a RenderBackend can render without a GPU (or any GL context).
+/// </summary>
+//NOTE: Buffers are plain CPU memory. Each pipeline's SoftwareShader gets BACKEND_CONSTANT_COUNT vec4s of frame constants,
+//      then BACKEND_CONSTANT_COUNT vec4s of draw constants, as its uniforms.
+class SoftwareBackend : public RenderBackend {
+    public:
+    static const unsigned int UNIFORM_COUNT = BACKEND_CONSTANT_COUNT * 4 * 2;
+
+    private:
+    struct Buffer {
+        BufferType type;
+        vector<unsigned char> data;
+    };
+
+    struct Pipeline {
+        const SoftwareShader* shader;
+        VertexBufferLayout layout;
+    };
+
+    SoftwareRasterizer rasterizer;
+    unsigned int nextId;
+
+    std::unordered_map<unsigned int, Buffer> buffers;
+    std::unordered_map<unsigned int, Pipeline> pipelines;
+    std::unordered_map<unsigned int, vector<DrawCommand>> commandLists;
+
+    float uniforms[UNIFORM_COUNT]; //The frame constants, followed by the draw constants of whichever draw we're on
+
+    public:
+    /// <param name="threadCount">See <see cref="SoftwareRasterizer"/>.</param>
+    SoftwareBackend(int width, int height, unsigned int threadCount = 0);
+
+    const char* getName() const override { return "Software"; }
+    inline const SoftwareRasterizer& getRasterizer() const { return rasterizer; }
+
+    BufferHandle createBuffer(BufferType type, const void* data, unsigned int size) override;
+    void updateBuffer(BufferHandle buffer, const void* data, unsigned int size, unsigned int offset = 0) override;
+    void destroyBuffer(BufferHandle buffer) override;
+
+    PipelineHandle createPipeline(const PipelineDesc& desc) override;
+    void destroyPipeline(PipelineHandle pipeline) override;
+
+    CommandListHandle recordCommands(const vector<DrawCommand>& draws) override;
+    void destroyCommands(CommandListHandle commands) override;
+
+    void beginFrame(float r, float g, float b, float a) override;
+    void setFrameConstants(const float constants[BACKEND_CONSTANT_COUNT][4]) override;
+    void submit(CommandListHandle commands) override;
+    void draw(const DrawCommand& command) override;
+
+    //NOTE: This is where everything drawn this frame actually gets rasterized.
+    void endFrame() override;
+
+    void readPixels(vector<unsigned char>& pixels) override;
+};
@@ -0,0 +1,383 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "CpuProfiler.h"
+#include "SoftwareRasterizer.h"
+#include "SoftwareRasterizerSimd.h"
+
+//NOTE: SSE2 is always there on x64 (and with /arch:SSE2, the default, on x86), so it's our baseline.
+//      AVX2 is picked at runtime instead (see pickSpanPath), so we still run on CPUs without it.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFTWARE_HAS_SSE2_SPANS
+#endif
+
+#if defined(SOFTWARE_HAS_AVX2_SPANS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static uint32_t packColor(const float color[4]) {
+    uint32_t packed;
+    unsigned char* bytes = (unsigned char*) &packed;
+    for (int i = 0; i < 4; i++) {
+        float value = std::min(std::max(color[i], 0.0f), 1.0f);
+        bytes[i] = (unsigned char) (value * 255 + 0.5f);
+    }
+    return packed;
+}
+
+//NOTE: Both triangles sharing an edge compute exactly opposite values for it (see setupTriangle), as long as it's always a * x + rowTerm.
+#ifdef SOFTWARE_HAS_SSE2_SPANS
+static unsigned int coverSpanSse2(const float a[3], const float rowTerms[3], const bool ownsEdge[3], float px, float edges[3][SOFTWARE_MAX_LANES]) {
+    __m128 x = _mm_add_ps(_mm_set1_ps(px), _mm_setr_ps(0, 1, 2, 3));
+    __m128 zero = _mm_setzero_ps();
+    unsigned int mask = 0xF;
+    for (int i = 0; i < 3; i++) {
+        __m128 e = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[i]), x), _mm_set1_ps(rowTerms[i]));
+        _mm_storeu_ps(edges[i], e);
+        __m128 inside = ownsEdge[i] ? _mm_cmpge_ps(e, zero) : _mm_cmpgt_ps(e, zero);
+        mask &= (unsigned int) _mm_movemask_ps(inside);
+    }
+    return mask;
+}
+#else
+static unsigned int coverSpanScalar(const float a[3], const float rowTerms[3], const bool ownsEdge[3], float px, float edges[3][SOFTWARE_MAX_LANES]) {
+    unsigned int mask = 1;
+    for (int i = 0; i < 3; i++) {
+        float e = a[i] * px;
+        e += rowTerms[i];
+        edges[i][0] = e;
+        if (ownsEdge[i] ? !(e >= 0) : !(e > 0))
+            mask = 0;
+    }
+    return mask;
+}
+#endif
+
+#ifdef SOFTWARE_HAS_AVX2_SPANS
+//Whether the CPU has AVX2 (and FMA, which MSVC may use with /arch:AVX2), and the OS saves the AVX registers when switching threads.
+static bool cpuHasAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!fma || !osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    //NOTE: Also checks the OS supports it.
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+#endif
+
+struct SpanPath {
+    const char* name;
+    int lanes;
+    SoftwareCoverSpan cover;
+};
+
+static SpanPath pickSpanPath() {
+#ifdef SOFTWARE_HAS_AVX2_SPANS
+    if (cpuHasAvx2())
+        return SpanPath { "AVX2", 8, coverSpanAvx2 };
+#endif
+#ifdef SOFTWARE_HAS_SSE2_SPANS
+    return SpanPath { "SSE2", 4, coverSpanSse2 };
+#else
+    return SpanPath { "scalar", 1, coverSpanScalar };
+#endif
+}
+
+static const SpanPath& getSpanPath() {
+    static const SpanPath path = pickSpanPath();
+    return path;
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height, unsigned int threadCount)
+    : width(std::max(width, 0)),
+    height(std::max(height, 0)),
+    colors((size_t) this->width * this->height, 0),
+    threadCount(threadCount != 0 ? threadCount : std::max(std::thread::hardware_concurrency(), 1u)),
+    tilesX((this->width + TILE_SIZE - 1) / TILE_SIZE),
+    tilesY((this->height + TILE_SIZE - 1) / TILE_SIZE),
+    bins(tilesX * tilesY),
+    flushCount(0),
+    busyWorkers(0),
+    stopping(false),
+    nextTile(0) {
+    //NOTE: More threads than tiles would never get any work. An empty target has no tiles at all, but flush()'s own thread still counts as one.
+    unsigned int workerCount = std::max(std::min(this->threadCount, (unsigned int) (tilesX * tilesY)), 1u) - 1;
+    workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; i++)
+        workers.emplace_back(&SoftwareRasterizer::workerLoop, this);
+}
+
+SoftwareRasterizer::~SoftwareRasterizer() {
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        stopping = true;
+    }
+    workStarted.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+const char* SoftwareRasterizer::getSimdName() {
+    return getSpanPath().name;
+}
+
+void SoftwareRasterizer::clear(float r, float g, float b, float a) {
+    //NOTE: Anything still queued would've been drawn before the clear, so it'd just get cleared anyway.
+    triangles.clear();
+    for (vector<unsigned int>& bin : bins)
+        bin.clear();
+    uniformData.clear();
+
+    const float color[4] = { r, g, b, a };
+    std::fill(colors.begin(), colors.end(), packColor(color));
+}
+
+void SoftwareRasterizer::draw(const void* vertexData, unsigned int vertexCount, const VertexBufferLayout& layout, const unsigned int* indices, unsigned int indexCount,
+    const SoftwareShader& shader, const float* uniforms, unsigned int uniformCount) {
+    PROFILE_SCOPE("SoftwareRasterizer::draw");
+    ASSERT(shader.getVaryingCount() <= SOFTWARE_MAX_VARYINGS);
+    fetchVertices(vertexData, vertexCount, layout, shader, uniforms);
+
+    unsigned int uniformOffset = (unsigned int) uniformData.size();
+    if (uniformCount > 0)
+        uniformData.insert(uniformData.end(), uniforms, uniforms + uniformCount);
+
+    for (unsigned int i = 0; i + 2 < indexCount; i += 3) {
+        ASSERT(indices[i] < vertexCount && indices[i + 1] < vertexCount && indices[i + 2] < vertexCount);
+        setupTriangle(transformed[indices[i]], transformed[indices[i + 1]], transformed[indices[i + 2]], shader, uniformOffset);
+    }
+}
+
+void SoftwareRasterizer::fetchVertices(const void* vertexData, unsigned int vertexCount, const VertexBufferLayout& layout, const SoftwareShader& shader,
+    const float* uniforms) {
+    const vector<VertexBufferAttribute>& layoutAttributes = layout.GetAttributes();
+    unsigned int floatCount = 0;
+    for (const VertexBufferAttribute& attribute : layoutAttributes) {
+        ASSERT(attribute.divisor == 0);
+        floatCount += attribute.count;
+    }
+    attributes.resize(floatCount);
+    transformed.resize(vertexCount);
+
+    const unsigned char* vertex = (const unsigned char*) vertexData;
+    for (unsigned int i = 0; i < vertexCount; i++, vertex += layout.getStride()) {
+        const unsigned char* source = vertex;
+        float* destination = attributes.data();
+        for (const VertexBufferAttribute& attribute : layoutAttributes) {
+            for (unsigned int j = 0; j < attribute.count; j++) {
+                switch (attribute.type) {
+                    case GL_FLOAT: {
+                        float value;
+                        memcpy(&value, source, sizeof(float));
+                        *destination = value;
+                        break;
+                    }
+                    case GL_UNSIGNED_INT: {
+                        unsigned int value;
+                        memcpy(&value, source, sizeof(unsigned int));
+                        *destination = (float) value;
+                        break;
+                    }
+                    case GL_UNSIGNED_BYTE:
+                        *destination = attribute.normalized ? *source / 255.0f : (float) *source;
+                        break;
+                }
+                source += VertexBufferAttribute::GetSizeOfType(attribute.type);
+                destination++;
+            }
+        }
+        shader.vertex(attributes.data(), uniforms, transformed[i]);
+    }
+}
+
+void SoftwareRasterizer::setupTriangle(const SoftwareVertex& v0, const SoftwareVertex& v1, const SoftwareVertex& v2, const SoftwareShader& shader, unsigned int uniformOffset) {
+    const SoftwareVertex* vertices[3] = { &v0, &v1, &v2 };
+    float x[3], y[3], inverseW[3];
+    for (int i = 0; i < 3; i++) {
+        const float* position = vertices[i]->position;
+        if (!(position[3] > 0))
+            return;
+        inverseW[i] = 1 / position[3];
+        x[i] = (position[0] * inverseW[i] * 0.5f + 0.5f) * width;
+        y[i] = (position[1] * inverseW[i] * 0.5f + 0.5f) * height;
+    }
+
+    //NOTE: Flip clockwise triangles around, so the inside is always where every edge function is positive.
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0 || std::isnan(area))
+        return;
+    if (area < 0) {
+        std::swap(vertices[1], vertices[2]);
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(inverseW[1], inverseW[2]);
+        area = -area;
+    }
+
+    Triangle triangle;
+    triangle.minX = std::max((int) std::floor(std::min(std::min(x[0], x[1]), x[2])), 0);
+    triangle.minY = std::max((int) std::floor(std::min(std::min(y[0], y[1]), y[2])), 0);
+    triangle.maxX = std::min((int) std::ceil(std::max(std::max(x[0], x[1]), x[2])), width - 1);
+    triangle.maxY = std::min((int) std::ceil(std::max(std::max(y[0], y[1]), y[2])), height - 1);
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+        return;
+
+    //Edge i goes from vertex i + 1 to vertex i + 2.
+    //NOTE: Going the other way around negates a, b and c exactly (floating point subtraction is antisymmetric), so for an edge shared by two triangles,
+    //      a pixel center is either inside exactly one of them, or exactly on the edge. Then ownsEdge (which is also antisymmetric) decides.
+    for (int i = 0; i < 3; i++) {
+        int p = (i + 1) % 3;
+        int q = (i + 2) % 3;
+        triangle.a[i] = y[p] - y[q];
+        triangle.b[i] = x[q] - x[p];
+        triangle.c[i] = x[p] * y[q] - y[p] * x[q];
+        triangle.ownsEdge[i] = triangle.a[i] > 0 || (triangle.a[i] == 0 && triangle.b[i] > 0);
+    }
+    triangle.inverseArea = 1 / area;
+
+    triangle.varyingCount = shader.getVaryingCount();
+    for (int i = 0; i < 3; i++) {
+        triangle.inverseW[i] = inverseW[i];
+        for (unsigned int j = 0; j < triangle.varyingCount; j++)
+            triangle.varyings[i][j] = vertices[i]->varyings[j] * inverseW[i];
+    }
+    triangle.shader = &shader;
+    triangle.uniformOffset = uniformOffset;
+
+    unsigned int index = (unsigned int) triangles.size();
+    triangles.push_back(triangle);
+    for (int tileY = triangle.minY / TILE_SIZE; tileY <= triangle.maxY / TILE_SIZE; tileY++) {
+        for (int tileX = triangle.minX / TILE_SIZE; tileX <= triangle.maxX / TILE_SIZE; tileX++)
+            bins[tileY * tilesX + tileX].push_back(index);
+    }
+}
+
+void SoftwareRasterizer::flush() {
+    PROFILE_SCOPE("SoftwareRasterizer::flush");
+    if (triangles.empty())
+        return;
+
+    //Every tile only touches its own pixels, so threads can just grab the next tile until there are none left.
+    nextTile = 0;
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        flushCount++;
+        busyWorkers = (unsigned int) workers.size();
+    }
+    workStarted.notify_all();
+    rasterizeTiles();
+    {
+        std::unique_lock<std::mutex> lock(workMutex);
+        workFinished.wait(lock, [this]() { return busyWorkers == 0; });
+    }
+
+    triangles.clear();
+    for (vector<unsigned int>& bin : bins)
+        bin.clear();
+    uniformData.clear();
+}
+
+void SoftwareRasterizer::workerLoop() {
+    uint64_t lastFlush = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(workMutex);
+            workStarted.wait(lock, [this, lastFlush]() { return stopping || flushCount != lastFlush; });
+            if (stopping)
+                return;
+            lastFlush = flushCount;
+        }
+
+        rasterizeTiles();
+
+        std::lock_guard<std::mutex> lock(workMutex);
+        if (--busyWorkers == 0)
+            workFinished.notify_one();
+    }
+}
+
+void SoftwareRasterizer::rasterizeTiles() {
+    PROFILE_SCOPE("SoftwareRasterizer tiles");
+    int tileCount = tilesX * tilesY;
+    for (int tile = nextTile++; tile < tileCount; tile = nextTile++)
+        rasterizeTile(tile);
+}
+
+void SoftwareRasterizer::rasterizeTile(int tile) {
+    int tileMinX = (tile % tilesX) * TILE_SIZE;
+    int tileMinY = (tile / tilesX) * TILE_SIZE;
+    int tileMaxX = std::min(tileMinX + TILE_SIZE, width) - 1;
+    int tileMaxY = std::min(tileMinY + TILE_SIZE, height) - 1;
+
+    const SpanPath& path = getSpanPath();
+    float edges[3][SOFTWARE_MAX_LANES];
+    float laneEdges[3];
+    for (unsigned int index : bins[tile]) {
+        const Triangle& triangle = triangles[index];
+        int minX = std::max(triangle.minX, tileMinX);
+        int maxX = std::min(triangle.maxX, tileMaxX);
+        int minY = std::max(triangle.minY, tileMinY);
+        int maxY = std::min(triangle.maxY, tileMaxY);
+
+        for (int y = minY; y <= maxY; y++) {
+            float py = y + 0.5f;
+            float rowTerms[3];
+            for (int i = 0; i < 3; i++)
+                rowTerms[i] = triangle.b[i] * py + triangle.c[i];
+
+            for (int x = minX; x <= maxX; x += path.lanes) {
+                unsigned int mask = path.cover(triangle.a, rowTerms, triangle.ownsEdge, x + 0.5f, edges);
+
+                //NOTE: The last span can stick out past the triangle's bounds (into the next tile), so drop those pixels.
+                int remaining = maxX - x + 1;
+                if (remaining < path.lanes)
+                    mask &= (1u << remaining) - 1;
+
+                for (int lane = 0; mask != 0; lane++, mask >>= 1) {
+                    if ((mask & 1) == 0)
+                        continue;
+                    laneEdges[0] = edges[0][lane];
+                    laneEdges[1] = edges[1][lane];
+                    laneEdges[2] = edges[2][lane];
+                    shadePixel(triangle, x + lane, y, laneEdges);
+                }
+            }
+        }
+    }
+}
+
+void SoftwareRasterizer::shadePixel(const Triangle& triangle, int x, int y, const float edges[3]) {
+    //The edge functions over the area are the barycentric coordinates, and things divided by w are linear in screen space.
+    float weights[3];
+    for (int i = 0; i < 3; i++)
+        weights[i] = edges[i] * triangle.inverseArea;
+    float inverseW = weights[0] * triangle.inverseW[0] + weights[1] * triangle.inverseW[1] + weights[2] * triangle.inverseW[2];
+
+    float varyings[SOFTWARE_MAX_VARYINGS];
+    for (unsigned int j = 0; j < triangle.varyingCount; j++) {
+        varyings[j] = (weights[0] * triangle.varyings[0][j] + weights[1] * triangle.varyings[1][j] + weights[2] * triangle.varyings[2][j]) / inverseW;
+    }
+
+    float color[4] = { 0, 0, 0, 1 };
+    //NOTE: Draws without uniforms still get a valid pointer (to whatever's there), which their shader just doesn't read.
+    triangle.shader->fragment(varyings, uniformData.data() + triangle.uniformOffset, color);
+    colors[(size_t) y * width + x] = packColor(color);
+}
+
+void SoftwareRasterizer::readPixels(vector<unsigned char>& pixels) const {
+    pixels.resize(colors.size() * 4);
+    memcpy(pixels.data(), colors.data(), pixels.size());
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "VertexBufferLayout.h"
+
+using std::vector;
+
+//Most floats a SoftwareShader can pass from its vertex function to its fragment function (like a GLSL "out", but all flattened into one array)
+static const unsigned int SOFTWARE_MAX_VARYINGS = 8;
+
+struct SoftwareVertex {
+    float position[4];  //In clip space, like gl_Position
+    float varyings[SOFTWARE_MAX_VARYINGS];
+};
+
+/// <summary>
+/// The C++ stand-in for a GLSL program, for the <see cref="SoftwareRasterizer"/>.
+/// Uniforms are whatever floats the draw passed in, laid out however the shader and its caller agree on.
+/// </summary>
+class SoftwareShader {
+    public:
+    virtual ~SoftwareShader() { }
+
+    //How many of SoftwareVertex::varyings the vertex function writes, so we only interpolate those.
+    virtual unsigned int getVaryingCount() const = 0;
+
+    /// <param name="attributes">The vertex's attributes, in the order of its VertexBufferLayout, each converted to floats (like OpenGL does for a vertex shader).</param>
+    virtual void vertex(const float* attributes, const float* uniforms, SoftwareVertex& out) const = 0;
+
+    /// <param name="varyings">Interpolated across the triangle (perspective-correct).</param>
+    /// <param name="color">RGBA, from 0 to 1.</param>
+    virtual void fragment(const float* varyings, const float* uniforms, float color[4]) const = 0;
+};
+
+/// <summary>
+/// Renders triangles on the CPU, into its own RGBA8 color buffer, for when there's no GPU (or GL context) at all, like making previews on a server.
+/// It takes the same vertex data, VertexBufferLayout and indices we'd upload to a VertexBuffer/IndexBuffer, and a SoftwareShader instead of a Shader.
+/// </summary>
+//NOTE: Draws are only queued up (transformed and set up) until flush(), which bins triangles into TILE_SIZE x TILE_SIZE tiles
+//      and rasterizes the tiles in parallel, one thread per core. The worker threads live as long as the rasterizer, and sleep between flushes. Each tile draws its triangles in the order they were submitted,
+//      so it looks just like drawing them one by one. Edge functions are evaluated 8 pixels at a time with AVX2 if the CPU has it, or else 4 with SSE2 (see getSimdName()).
+//      There's no depth test or blending (our demo uses neither), triangles are never culled (like OpenGL's default),
+//      and triangles with any vertex behind the camera (w <= 0) are skipped instead of clipped.
+class SoftwareRasterizer {
+    public:
+    static const int TILE_SIZE = 64;
+
+    private:
+    //A triangle ready to rasterize, in pixels
+    struct Triangle {
+        //Edge i is the one across from vertex i, and E(x, y) = a * x + (b * y + c) is positive inside.
+        float a[3];
+        float b[3];
+        float c[3];
+        bool ownsEdge[3];   //Whether pixels exactly on edge i are ours, so pixels on an edge shared by two triangles get drawn exactly once
+        float inverseArea;
+
+        int minX, minY, maxX, maxY; //Bounds, in pixels, inclusive
+
+        //Per vertex: 1 / w, and the varyings divided by w, which are what's linear in screen space
+        float inverseW[3];
+        float varyings[3][SOFTWARE_MAX_VARYINGS];
+        unsigned int varyingCount;
+
+        const SoftwareShader* shader;
+        unsigned int uniformOffset; //Into uniformData
+    };
+
+    int width;
+    int height;
+    vector<uint32_t> colors; //RGBA8, bottom row first (like OpenGL)
+
+    unsigned int threadCount;
+    int tilesX;
+    int tilesY;
+
+    vector<Triangle> triangles;
+    vector<vector<unsigned int>> bins; //Per tile, the triangles that touch it, in submission order
+    vector<float> uniformData; //Every queued draw's uniforms, since the caller's don't have to outlive the draw
+
+    //Scratch space, kept between draws so we don't allocate every time
+    vector<SoftwareVertex> transformed;
+    vector<float> attributes;
+
+    //The threads that help flush() rasterize tiles (flush()'s own thread is the other one)
+    vector<std::thread> workers;
+    std::mutex workMutex;
+    std::condition_variable workStarted;   //Workers wait on this for the next flush (or for stopping)
+    std::condition_variable workFinished;  //flush() waits on this for the workers to run out of tiles
+    uint64_t flushCount;                    //Bumped for each flush, so workers know there's new work
+    unsigned int busyWorkers;
+    bool stopping;
+    std::atomic<int> nextTile;
+
+    public:
+    /// <param name="threadCount">How many threads rasterize tiles, or 0 for one per core.</param>
+    SoftwareRasterizer(int width, int height, unsigned int threadCount = 0);
+    ~SoftwareRasterizer();
+
+    //NOTE: Owns its worker threads, so no copies.
+    SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+    SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+    inline int getWidth() const { return width; }
+    inline int getHeight() const { return height; }
+    inline unsigned int getThreadCount() const { return threadCount; }
+
+    void clear(float r, float g, float b, float a);
+
+    /// <summary>
+    /// Queues indexCount / 3 triangles, made of vertices from vertexData (laid out like layout says).
+    /// The shader must stay alive (and unchanged) until the next flush(), but the uniforms are copied.
+    /// </summary>
+    //NOTE: Per-instance attributes aren't supported, so every attribute in the layout must have a divisor of 0.
+    void draw(const void* vertexData, unsigned int vertexCount, const VertexBufferLayout& layout, const unsigned int* indices, unsigned int indexCount,
+        const SoftwareShader& shader, const float* uniforms = nullptr, unsigned int uniformCount = 0);
+
+    /// <summary>
+    /// Rasterizes everything drawn since the last flush.
+    /// </summary>
+    void flush();
+
+    /// <summary>
+    /// Same as <see cref="Framebuffer::readPixels"/>: tightly packed RGBA8 rows, bottom row first.
+    /// </summary>
+    void readPixels(vector<unsigned char>& pixels) const;
+
+    //Which instruction set we rasterize with, picked the first time it's needed from what the CPU supports
+    static const char* getSimdName();
+
+    private:
+    void fetchVertices(const void* vertexData, unsigned int vertexCount, const VertexBufferLayout& layout, const SoftwareShader& shader, const float* uniforms);
+    void setupTriangle(const SoftwareVertex& v0, const SoftwareVertex& v1, const SoftwareVertex& v2, const SoftwareShader& shader, unsigned int uniformOffset);
+    void workerLoop();
+
+    //Grabs tiles (counting up from nextTile) and rasterizes them until there are none left
+    void rasterizeTiles();
+    void rasterizeTile(int tile);
+    void shadePixel(const Triangle& triangle, int x, int y, const float edges[3]);
+};
@@ -0,0 +1,27 @@
+#include "SoftwareRasterizerSimd.h"
+
+#ifdef SOFTWARE_HAS_AVX2_SPANS
+#include <immintrin.h>
+
+//NOTE: MSVC builds this file with /arch:AVX2 (see the vcxproj). GCC and Clang need the target attribute instead,
+//      since they won't let us use AVX intrinsics in a function that isn't built for AVX.
+#if defined(__GNUC__) || defined(__clang__)
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#else
+#define AVX2_FUNCTION
+#endif
+
+//NOTE: Both triangles sharing an edge compute exactly opposite values for it (see SoftwareRasterizer::setupTriangle), as long as it's always a * x + rowTerm.
+AVX2_FUNCTION unsigned int coverSpanAvx2(const float a[3], const float rowTerms[3], const bool ownsEdge[3], float px, float edges[3][SOFTWARE_MAX_LANES]) {
+    __m256 x = _mm256_add_ps(_mm256_set1_ps(px), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256 zero = _mm256_setzero_ps();
+    unsigned int mask = 0xFF;
+    for (int i = 0; i < 3; i++) {
+        __m256 e = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[i]), x), _mm256_set1_ps(rowTerms[i]));
+        _mm256_storeu_ps(edges[i], e);
+        __m256 inside = ownsEdge[i] ? _mm256_cmp_ps(e, zero, _CMP_GE_OQ) : _mm256_cmp_ps(e, zero, _CMP_GT_OQ);
+        mask &= (unsigned int) _mm256_movemask_ps(inside);
+    }
+    return mask;
+}
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+//The parts of SoftwareRasterizer that are built for one particular instruction set, in their own files, so only they need it enabled.
+//Which one we use is picked when we run (see SoftwareRasterizer::getSimdName), so the rest of the program still runs on CPUs without it.
+
+//The most pixels any of the span functions test at once
+static const int SOFTWARE_MAX_LANES = 8;
+
+//Tests a span of pixels in a row, starting at pixel center px, against all three edges, writing out each edge's value at each pixel.
+//Returns a bit per pixel, set if it's inside the triangle.
+typedef unsigned int (*SoftwareCoverSpan)(const float a[3], const float rowTerms[3], const bool ownsEdge[3], float px, float edges[3][SOFTWARE_MAX_LANES]);
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SOFTWARE_HAS_AVX2_SPANS
+
+//8 pixels at a time. Only call it if the CPU (and OS) support AVX2.
+//NOTE: In SoftwareRasterizerAvx2.cpp, the only file built with AVX2 enabled (see the vcxproj).
+unsigned int coverSpanAvx2(const float a[3], const float rowTerms[3], const bool ownsEdge[3], float px, float edges[3][SOFTWARE_MAX_LANES]);
+#endif
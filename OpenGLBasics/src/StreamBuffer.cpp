@@ -0,0 +1,145 @@
+#include "OpenGLUtil.h"
+#include "GLStateCache.h"
+#include "RedrawTracker.h"
+#include "RenderStats.h"
+#include "GLTrace.h"
+#include "StreamBuffer.h"
+
+StreamBuffer::StreamBuffer(unsigned int target, unsigned int regionSize, unsigned int regionCount)
+    : rendererId(0),
+    target(target),
+    regionSize(regionSize),
+    regionCount(regionCount),
+    region(0),
+    cursor(0),
+    mapped(false),
+    persistent(isPersistentSupported()),
+    mappedData(nullptr) {
+
+    GLCALL(glGenBuffers(1, &rendererId));
+    RenderStats::get().onBufferCreated();
+    bind();
+
+    if (persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        unsigned int size = regionSize * regionCount;
+        GLCALL(glBufferStorage(target, size, nullptr, flags));
+        GLCALL(mappedData = (char*) glMapBufferRange(target, 0, size, flags));
+        fences.resize(regionCount, nullptr);
+    } else {
+        GLCALL(glBufferData(target, regionSize, nullptr, GL_STREAM_DRAW));
+        staging.resize(regionSize);
+    }
+}
+
+StreamBuffer::~StreamBuffer() {
+    for (GLsync fence : fences) {
+        if (fence != nullptr) {
+            GLCALL(glDeleteSync(fence));
+        }
+    }
+    //NOTE: Deleting the buffer unmaps it too.
+    GLCALL(glDeleteBuffers(1, &rendererId));
+    GLStateCache::get().onBufferDeleted(rendererId);
+    RenderStats::get().onBufferDeleted();
+}
+
+bool StreamBuffer::isPersistentSupported() {
+    return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+}
+
+void* StreamBuffer::map(unsigned int maxSize, unsigned int alignment, unsigned int& offset) {
+    ASSERT(!mapped);
+    ASSERT(maxSize <= regionSize);
+
+    //Align the absolute offset (not just the one within the region), since that's what draws will use.
+    unsigned int regionStart = persistent ? region * regionSize : 0;
+    unsigned int start = regionStart + cursor;
+    if (alignment > 1 && start % alignment != 0)
+        start += alignment - start % alignment;
+    cursor = start - regionStart;
+
+    if (cursor + maxSize > regionSize) {
+        //Out of room in this region, so move on without waiting for the end of the frame.
+        if (persistent)
+            nextRegion();
+        else
+            orphan();
+        return map(maxSize, alignment, offset);
+    }
+
+    mapped = true;
+    offset = start;
+    if (persistent)
+        return mappedData + start;
+    return staging.data() + cursor;
+}
+
+void StreamBuffer::unmap(unsigned int usedSize) {
+    ASSERT(mapped);
+    mapped = false;
+
+    //NOTE: The persistent mapping is coherent, so there's nothing to flush. But writing to it isn't a GL call, so a capture would miss it.
+    if (persistent && usedSize > 0 && GLTrace::isCapturing()) {
+        unsigned int start = region * regionSize + cursor;
+        GLTrace::recordMappedWrite(rendererId, start, usedSize, mappedData + start);
+    }
+    if (!persistent && usedSize > 0) {
+        bind();
+        GLCALL(glBufferSubData(target, cursor, usedSize, staging.data() + cursor));
+    }
+    RenderStats::get().onBufferUpload(usedSize);
+    RedrawTracker::get().invalidate();
+    cursor += usedSize;
+}
+
+void StreamBuffer::endFrame() {
+    ASSERT(!mapped);
+    if (persistent)
+        nextRegion();
+    else
+        orphan();
+}
+
+void StreamBuffer::bind() const {
+    GLStateCache::get().bindBuffer(target, rendererId);
+}
+
+void StreamBuffer::unbind() const {
+    GLStateCache::get().bindBuffer(target, 0);
+}
+
+void StreamBuffer::nextRegion() {
+    //Any draws reading from this region have been issued by now, so the fence signals once the GPU's done with them.
+    GLCALL(fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    region = (region + 1) % regionCount;
+    cursor = 0;
+
+    GLsync fence = fences[region];
+    if (fence == nullptr)
+        return;
+
+    //NOTE: The first wait flushes, so the fence is sure to get to the GPU and we can't wait forever.
+    GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (true) {
+        GLenum result;
+        GLCALL(result = glClientWaitSync(fence, waitFlags, 1000000)); //1ms, in nanoseconds
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+            break;
+        if (result == GL_WAIT_FAILED) {
+            ASSERT(false);
+            break;
+        }
+        waitFlags = 0;
+    }
+    GLCALL(glDeleteSync(fence));
+    fences[region] = nullptr;
+}
+
+void StreamBuffer::orphan() {
+    //Hand the old storage back to the driver (draws still using it keep it alive) and start writing into fresh storage right away.
+    bind();
+    GLCALL(glBufferData(target, regionSize, nullptr, GL_STREAM_DRAW));
+    cursor = 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <GL/glew.h>
+
+using std::vector;
+
+/// <summary>
+/// A buffer for geometry that changes every frame, which we write straight into mapped memory instead of re-uploading with glBufferData.
+/// It's split into regionCount regions (one per frame in flight), each guarded by a fence, so we never write over data the GPU is still reading.
+/// </summary>
+//NOTE: Needs OpenGL 4.4 or ARB_buffer_storage for the persistent mapping. Without it, we fall back to writing into
+//      CPU memory and uploading with glBufferSubData, orphaning the buffer each frame so the driver doesn't have to sync.
+//
+//Usage, once or more per frame:
+//      void* data = buffer.map(maxSize, alignment, offset);    //Write up to maxSize bytes to data...
+//      buffer.unmap(usedSize);                                 //...then draw from offset (in bytes) in the buffer.
+//And at the end of each frame:
+//      buffer.endFrame();
+class StreamBuffer {
+    private:
+    unsigned int rendererId;
+    unsigned int target;
+    unsigned int regionSize;
+    unsigned int regionCount;
+
+    unsigned int region;    //The region we're writing to this frame
+    unsigned int cursor;    //Where the next write goes, relative to the start of the region
+    bool mapped;
+
+    bool persistent;
+    char* mappedData;       //Persistent path: the whole buffer, mapped for as long as it lives
+    vector<GLsync> fences;  //Persistent path: one per region, or nullptr when the GPU is done with it
+    vector<char> staging;   //Fallback path: where we write before uploading
+
+    public:
+    /// <param name="regionSize">The size (in bytes) of each frame's region. Writes that don't fit move on to the next region early.</param>
+    StreamBuffer(unsigned int target, unsigned int regionSize, unsigned int regionCount = 3);
+    ~StreamBuffer();
+
+    static bool isPersistentSupported();
+
+    /// <summary>
+    /// Reserves up to maxSize bytes to write to. Call <see cref="unmap"/> with however much you actually wrote before drawing from it.
+    /// </summary>
+    /// <param name="alignment">What the offset needs to be a multiple of, e.g. the vertex stride, so it can be used as a base vertex.</param>
+    /// <param name="offset">Set to where the data will be in the buffer, in bytes.</param>
+    void* map(unsigned int maxSize, unsigned int alignment, unsigned int& offset);
+    void unmap(unsigned int usedSize);
+
+    /// <summary>
+    /// Fences this frame's region, and moves on to the next one (waiting for the GPU to finish reading it, if it hasn't yet).
+    /// </summary>
+    void endFrame();
+
+    inline bool isPersistent() const { return persistent; }
+
+    void bind() const;
+    void unbind() const;
+
+    private:
+    void nextRegion();
+    void orphan();
+};
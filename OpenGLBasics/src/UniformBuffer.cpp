@@ -0,0 +1,107 @@
+#include <cstring>
+
+#include "OpenGLUtil.h"
+#include "GLStateCache.h"
+#include "RedrawTracker.h"
+#include "RenderStats.h"
+#include "UniformBuffer.h"
+
+unsigned int Std140Layout::push(unsigned int components, unsigned int arrayLength) {
+    ASSERT(components >= 1 && components <= 4);
+
+    if (arrayLength > 0) {
+        unsigned int offset = align(16);
+        size += 16 * arrayLength;
+        return offset;
+    }
+
+    unsigned int alignment = components == 1 ? 4 : components == 2 ? 8 : 16;
+    unsigned int offset = align(alignment);
+    size += 4 * components;
+    return offset;
+}
+
+unsigned int Std140Layout::pushMat4(unsigned int arrayLength) {
+    unsigned int offset = align(16);
+    size += 64 * (arrayLength > 0 ? arrayLength : 1);
+    return offset;
+}
+
+unsigned int Std140Layout::align(unsigned int alignment) {
+    size = (size + alignment - 1) & ~(alignment - 1);
+    return size;
+}
+
+unordered_map<string, unsigned int> UniformBuffer::bindingPoints;
+
+UniformBuffer::UniformBuffer(const string& blockName, unsigned int size)
+    : rendererId(0),
+    bindingPoint(getBindingPoint(blockName)),
+    data(size),
+    dirty(true) {
+    GLCALL(glGenBuffers(1, &rendererId));
+    RenderStats::get().onBufferCreated();
+    GLStateCache::get().bindBuffer(GL_UNIFORM_BUFFER, rendererId);
+    GLCALL(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    bind();
+}
+
+UniformBuffer::~UniformBuffer() {
+    GLCALL(glDeleteBuffers(1, &rendererId));
+    GLStateCache::get().onBufferDeleted(rendererId);
+    RenderStats::get().onBufferDeleted();
+}
+
+unsigned int UniformBuffer::getBindingPoint(const string& blockName) {
+    unordered_map<string, unsigned int>::iterator it = bindingPoints.find(blockName);
+    if (it != bindingPoints.end())
+        return it->second;
+
+    unsigned int bindingPoint = (unsigned int) bindingPoints.size();
+    bindingPoints[blockName] = bindingPoint;
+    return bindingPoint;
+}
+
+void UniformBuffer::set(unsigned int offset, const void* value, unsigned int size) {
+    ASSERT(offset + size <= data.size());
+    if (memcmp(&data[offset], value, size) == 0)
+        return;
+    memcpy(&data[offset], value, size);
+    dirty = true;
+}
+
+void UniformBuffer::setFloat(unsigned int offset, float value) {
+    set(offset, &value, sizeof(float));
+}
+
+void UniformBuffer::setInt(unsigned int offset, int value) {
+    set(offset, &value, sizeof(int));
+}
+
+void UniformBuffer::setVec4(unsigned int offset, float v0, float v1, float v2, float v3) {
+    const float value[4] = { v0, v1, v2, v3 };
+    set(offset, value, sizeof(value));
+}
+
+void UniformBuffer::setMat4(unsigned int offset, const float* columnMajor) {
+    set(offset, columnMajor, 16 * sizeof(float));
+}
+
+void UniformBuffer::upload() {
+    if (!dirty)
+        return;
+    GLStateCache::get().bindBuffer(GL_UNIFORM_BUFFER, rendererId);
+    GLCALL(glBufferSubData(GL_UNIFORM_BUFFER, 0, (GLsizeiptr) data.size(), data.data()));
+    RenderStats::get().onUniformUpload();
+    RenderStats::get().onBufferUpload(data.size());
+    RedrawTracker::get().invalidate();
+    dirty = false;
+}
+
+void UniformBuffer::bind() const {
+    GLStateCache::get().bindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, rendererId);
+}
+
+void UniformBuffer::unbind() const {
+    GLStateCache::get().bindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, 0);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+/// <summary>
+/// Works out where each member of a GLSL "layout(std140) uniform" block goes, so our CPU copy matches the GPU's layout.
+/// Push the members in the same order as the block declares them, and keep the offsets that come back.
+/// </summary>
+//NOTE: The std140 rules, in short: scalars align to 4 bytes, vec2 to 8, vec3 and vec4 to 16.
+//      Every element of an array (and every column of a matrix) is padded out to 16 bytes.
+class Std140Layout {
+    private:
+    unsigned int size;
+
+    public:
+    Std140Layout()
+        : size(0) { }
+
+    //NOTE: For float, int, uint and bool members (they're all 4 bytes in std140), with 1-4 components.
+    /// <param name="arrayLength">0 for a plain member, or the length of the array.</param>
+    unsigned int push(unsigned int components, unsigned int arrayLength = 0);
+    unsigned int pushMat4(unsigned int arrayLength = 0);
+
+    //NOTE: The block's total size gets rounded up to a multiple of 16, just like a struct would.
+    inline unsigned int getSize() const { return (size + 15) & ~15u; }
+
+    private:
+    unsigned int align(unsigned int alignment);
+};
+
+/// <summary>
+/// A uniform buffer object backing a named uniform block. Every Shader that declares the block reads from it,
+/// so per-frame data (camera, time, lighting) gets uploaded once instead of once per program.
+/// </summary>
+//NOTE: Block names map to binding points through a registry, shared by Shader (when it links) and UniformBuffer,
+//      so it doesn't matter which gets created first.
+class UniformBuffer {
+    private:
+    static unordered_map<string, unsigned int> bindingPoints;
+
+    unsigned int rendererId;
+    unsigned int bindingPoint;
+    vector<char> data;
+    bool dirty;
+
+    public:
+    /// <param name="size">In bytes. See <see cref="Std140Layout::getSize"/>.</param>
+    UniformBuffer(const string& blockName, unsigned int size);
+    ~UniformBuffer();
+
+    /// <summary>
+    /// Gets the binding point for a uniform block name, assigning the next free one the first time we see the name.
+    /// </summary>
+    static unsigned int getBindingPoint(const string& blockName);
+
+    //NOTE: These only write our CPU copy. Call upload() once after setting everything for the frame.
+    void set(unsigned int offset, const void* value, unsigned int size);
+    void setFloat(unsigned int offset, float value);
+    void setInt(unsigned int offset, int value);
+    void setVec4(unsigned int offset, float v0, float v1, float v2, float v3);
+    void setMat4(unsigned int offset, const float* columnMajor);
+
+    /// <summary>
+    /// Sends our CPU copy to the GPU, if anything changed since the last upload.
+    /// </summary>
+    void upload();
+
+    inline unsigned int getBindingPoint() const { return bindingPoint; }
+
+    void bind() const;
+    void unbind() const;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+static const uint32_t UNIFORM_ID_OFFSET_BASIS = 2166136261u;
+static const uint32_t UNIFORM_ID_PRIME = 16777619u;
+
+//32-bit FNV-1a of the first length characters of name
+constexpr uint32_t hashUniformName(const char* name, size_t length) {
+    uint32_t hash = UNIFORM_ID_OFFSET_BASIS;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char) name[i];
+        hash *= UNIFORM_ID_PRIME;
+    }
+    return hash;
+}
+
+/// <summary>
+/// A uniform name, hashed (at compile time, when written as "u_Color"_u), so looking it up in a Shader's uniform table is just comparing integers.
+/// </summary>
+//NOTE: Shader checks its own uniforms' hashes for collisions when it reflects them, so two names that hash the same can't both be in one shader.
+struct UniformId {
+    uint32_t hash;
+
+    constexpr explicit UniformId(uint32_t hash) : hash(hash) { }
+};
+
+constexpr UniformId operator"" _u(const char* name, size_t length) {
+    return UniformId(hashUniformName(name, length));
+}
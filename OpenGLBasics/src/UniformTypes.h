@@ -0,0 +1,122 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include "OpenGLUtil.h"
+
+//The C++ side of each GLSL uniform type, for typed uniform handles (see Shader::getUniform).
+//Scalars are just float, double, int (also for bools and samplers) and unsigned int. Matrices are column-major, like OpenGL wants them,
+//so MatCxR (like GLSL's matCxR) is C columns of R rows.
+//NOTE: The double types need GL 4.0 (or ARB_gpu_shader_fp64) on the GLSL side. Samplers' other siblings (images, atomic counters) aren't supported.
+struct Vec2 { float x, y; };
+struct Vec3 { float x, y, z; };
+struct Vec4 { float x, y, z, w; };
+struct IVec2 { int x, y; };
+struct IVec3 { int x, y, z; };
+struct IVec4 { int x, y, z, w; };
+struct UVec2 { unsigned int x, y; };
+struct UVec3 { unsigned int x, y, z; };
+struct UVec4 { unsigned int x, y, z, w; };
+struct Mat2 { float columns[2][2]; };
+struct Mat3 { float columns[3][3]; };
+struct Mat4 { float columns[4][4]; };
+struct Mat2x3 { float columns[2][3]; };
+struct Mat2x4 { float columns[2][4]; };
+struct Mat3x2 { float columns[3][2]; };
+struct Mat3x4 { float columns[3][4]; };
+struct Mat4x2 { float columns[4][2]; };
+struct Mat4x3 { float columns[4][3]; };
+struct DVec2 { double x, y; };
+struct DVec3 { double x, y, z; };
+struct DVec4 { double x, y, z, w; };
+struct DMat2 { double columns[2][2]; };
+struct DMat3 { double columns[3][3]; };
+struct DMat4 { double columns[4][4]; };
+struct DMat2x3 { double columns[2][3]; };
+struct DMat2x4 { double columns[2][4]; };
+struct DMat3x2 { double columns[3][2]; };
+struct DMat3x4 { double columns[3][4]; };
+struct DMat4x2 { double columns[4][2]; };
+struct DMat4x3 { double columns[4][3]; };
+
+/// <summary>
+/// Which GLSL types a C++ type can be uploaded to, and how.
+/// </summary>
+template <typename T>
+struct UniformType;
+
+static inline bool isSamplerType(GLenum type) {
+    switch (type) {
+        case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_1D_SHADOW: case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_1D_ARRAY: case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_1D_ARRAY_SHADOW: case GL_SAMPLER_2D_ARRAY_SHADOW: case GL_SAMPLER_CUBE_SHADOW: case GL_SAMPLER_BUFFER:
+        case GL_SAMPLER_2D_RECT: case GL_SAMPLER_2D_RECT_SHADOW: case GL_SAMPLER_2D_MULTISAMPLE: case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+        case GL_INT_SAMPLER_1D: case GL_INT_SAMPLER_2D: case GL_INT_SAMPLER_3D: case GL_INT_SAMPLER_CUBE:
+        case GL_INT_SAMPLER_1D_ARRAY: case GL_INT_SAMPLER_2D_ARRAY: case GL_INT_SAMPLER_BUFFER: case GL_INT_SAMPLER_2D_RECT:
+        case GL_INT_SAMPLER_2D_MULTISAMPLE: case GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+        case GL_UNSIGNED_INT_SAMPLER_1D: case GL_UNSIGNED_INT_SAMPLER_2D: case GL_UNSIGNED_INT_SAMPLER_3D: case GL_UNSIGNED_INT_SAMPLER_CUBE:
+        case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY: case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY: case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+        case GL_UNSIGNED_INT_SAMPLER_2D_RECT: case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE: case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+            return true;
+    }
+    return false;
+}
+
+//NOTE: Every upload is a glUniform*v, so arrays and single values go through the same call.
+#define UNIFORM_TYPE(T, matchExpression, uploadCall) \
+    template <> \
+    struct UniformType<T> { \
+        static inline bool matches(GLenum type) { return matchExpression; } \
+        static inline void upload(int location, int count, const T* values) { GLCALL(uploadCall); } \
+    };
+
+UNIFORM_TYPE(float, type == GL_FLOAT, glUniform1fv(location, count, values))
+UNIFORM_TYPE(Vec2, type == GL_FLOAT_VEC2, glUniform2fv(location, count, &values->x))
+UNIFORM_TYPE(Vec3, type == GL_FLOAT_VEC3, glUniform3fv(location, count, &values->x))
+UNIFORM_TYPE(Vec4, type == GL_FLOAT_VEC4, glUniform4fv(location, count, &values->x))
+UNIFORM_TYPE(int, type == GL_INT || type == GL_BOOL || isSamplerType(type), glUniform1iv(location, count, values))
+UNIFORM_TYPE(IVec2, type == GL_INT_VEC2 || type == GL_BOOL_VEC2, glUniform2iv(location, count, &values->x))
+UNIFORM_TYPE(IVec3, type == GL_INT_VEC3 || type == GL_BOOL_VEC3, glUniform3iv(location, count, &values->x))
+UNIFORM_TYPE(IVec4, type == GL_INT_VEC4 || type == GL_BOOL_VEC4, glUniform4iv(location, count, &values->x))
+UNIFORM_TYPE(unsigned int, type == GL_UNSIGNED_INT, glUniform1uiv(location, count, values))
+UNIFORM_TYPE(UVec2, type == GL_UNSIGNED_INT_VEC2, glUniform2uiv(location, count, &values->x))
+UNIFORM_TYPE(UVec3, type == GL_UNSIGNED_INT_VEC3, glUniform3uiv(location, count, &values->x))
+UNIFORM_TYPE(UVec4, type == GL_UNSIGNED_INT_VEC4, glUniform4uiv(location, count, &values->x))
+UNIFORM_TYPE(Mat2, type == GL_FLOAT_MAT2, glUniformMatrix2fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(Mat3, type == GL_FLOAT_MAT3, glUniformMatrix3fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(Mat4, type == GL_FLOAT_MAT4, glUniformMatrix4fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(Mat2x3, type == GL_FLOAT_MAT2x3, glUniformMatrix2x3fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(Mat2x4, type == GL_FLOAT_MAT2x4, glUniformMatrix2x4fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(Mat3x2, type == GL_FLOAT_MAT3x2, glUniformMatrix3x2fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(Mat3x4, type == GL_FLOAT_MAT3x4, glUniformMatrix3x4fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(Mat4x2, type == GL_FLOAT_MAT4x2, glUniformMatrix4x2fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(Mat4x3, type == GL_FLOAT_MAT4x3, glUniformMatrix4x3fv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(double, type == GL_DOUBLE, glUniform1dv(location, count, values))
+UNIFORM_TYPE(DVec2, type == GL_DOUBLE_VEC2, glUniform2dv(location, count, &values->x))
+UNIFORM_TYPE(DVec3, type == GL_DOUBLE_VEC3, glUniform3dv(location, count, &values->x))
+UNIFORM_TYPE(DVec4, type == GL_DOUBLE_VEC4, glUniform4dv(location, count, &values->x))
+UNIFORM_TYPE(DMat2, type == GL_DOUBLE_MAT2, glUniformMatrix2dv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(DMat3, type == GL_DOUBLE_MAT3, glUniformMatrix3dv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(DMat4, type == GL_DOUBLE_MAT4, glUniformMatrix4dv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(DMat2x3, type == GL_DOUBLE_MAT2x3, glUniformMatrix2x3dv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(DMat2x4, type == GL_DOUBLE_MAT2x4, glUniformMatrix2x4dv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(DMat3x2, type == GL_DOUBLE_MAT3x2, glUniformMatrix3x2dv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(DMat3x4, type == GL_DOUBLE_MAT3x4, glUniformMatrix3x4dv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(DMat4x2, type == GL_DOUBLE_MAT4x2, glUniformMatrix4x2dv(location, count, GL_FALSE, &values->columns[0][0]))
+UNIFORM_TYPE(DMat4x3, type == GL_DOUBLE_MAT4x3, glUniformMatrix4x3dv(location, count, GL_FALSE, &values->columns[0][0]))
+
+#undef UNIFORM_TYPE
+
+/// <summary>
+/// An active uniform of one Shader, checked to be of type T when it was looked up, so setting it is just a table lookup (no names, no GL queries).
+/// </summary>
+//NOTE: Only good for the Shader it came from. Invalid (index -1) if the shader has no such uniform (e.g. the compiler optimized it out), in which case setting it does nothing.
+template <typename T>
+struct UniformHandle {
+    int index;
+
+    UniformHandle() : index(-1) { }
+    explicit UniformHandle(int index) : index(index) { }
+
+    inline bool isValid() const { return index >= 0; }
+};
@@ -1,34 +1,69 @@
+#include <cstdint>
+
 #include "OpenGLUtil.h"
+#include "CpuProfiler.h"
+#include "GLStateCache.h"
+#include "RenderStats.h"
 #include "VertexArray.h"
 #include "VertexBufferLayout.h"
 
-VertexArray::VertexArray() {
+VertexArray::VertexArray()
+    : attributeCount(0) {
     GLCALL(glGenVertexArrays(1, &rendererId));
+    RenderStats::get().onVertexArrayCreated();
 }
 
 VertexArray::~VertexArray() {
     GLCALL(glDeleteVertexArrays(1, &rendererId));
+    GLStateCache::get().onVertexArrayDeleted(rendererId);
+    RenderStats::get().onVertexArrayDeleted();
 }
 
 void VertexArray::addBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout) {
+    PROFILE_SCOPE("VertexArray::addBuffer");
     bind();
     vb.bind();
-    const vector<VertexBufferAttribute>& attributes = layout.GetAttributes();
-
-    unsigned int offset = 0;
-    for (unsigned int i = 0; i < attributes.size(); i++) {
-        const VertexBufferAttribute attribute = attributes[i];
-        GLCALL(glEnableVertexAttribArray(i));
-        GLCALL(glVertexAttribPointer(i, attribute.count, attribute.type, attribute.normalized, layout.getStride(), (const void*) offset));
-        offset += attribute.count * VertexBufferAttribute::GetSizeOfType(attribute.type);
-    }
+    addAttributes(layout);
+}
 
+void VertexArray::addBuffer(const StreamBuffer& buffer, const VertexBufferLayout& layout) {
+    PROFILE_SCOPE("VertexArray::addBuffer");
+    bind();
+    buffer.bind();
+    addAttributes(layout);
 }
 
 void VertexArray::bind() const {
-    GLCALL(glBindVertexArray(rendererId));
+    GLStateCache::get().bindVertexArray(rendererId);
 }
 
 void VertexArray::unbind() const {
-    GLCALL(glBindVertexArray(0));
+    GLStateCache::get().bindVertexArray(0);
+}
+
+void VertexArray::addAttributes(const VertexBufferLayout& layout) {
+    const vector<VertexBufferAttribute>& attributes = layout.GetAttributes();
+
+    //NOTE: Attribute locations continue from any buffers added before this one,
+    //      so per-vertex and per-instance data can live in separate buffers.
+    unsigned int offset = 0;
+    for (unsigned int i = 0; i < attributes.size(); i++) {
+        const VertexBufferAttribute attribute = attributes[i];
+        unsigned int typeSize = VertexBufferAttribute::GetSizeOfType(attribute.type);
+
+        //A single location holds at most 4 components, so bigger attributes (like a mat4 per instance) take up several locations in a row.
+        for (unsigned int component = 0; component < attribute.count; component += 4) {
+            unsigned int componentCount = attribute.count - component;
+            if (componentCount > 4)
+                componentCount = 4;
+
+            unsigned int location = attributeCount++;
+            GLCALL(glEnableVertexAttribArray(location));
+            GLCALL(glVertexAttribPointer(location, componentCount, attribute.type, attribute.normalized, layout.getStride(), (const void*) (uintptr_t) offset));
+            if (attribute.divisor != 0) {
+                GLCALL(glVertexAttribDivisor(location, attribute.divisor));
+            }
+            offset += componentCount * typeSize;
+        }
+    }
 }
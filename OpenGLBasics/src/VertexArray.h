@@ -1,17 +1,28 @@
 #pragma once
 
+#include "StreamBuffer.h"
 #include "VertexBuffer.h"
 #include "VertexBufferLayout.h"
 
 class VertexArray {
     private:
     unsigned int rendererId;
+    unsigned int attributeCount;
 
     public:
     VertexArray();
     ~VertexArray();
 
+    inline unsigned int getRendererId() const { return rendererId; }
+
     void addBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+
+    //NOTE: Attributes point at the start of the stream buffer, so draw from the offset map() gave you using a base vertex (offset / stride).
+    void addBuffer(const StreamBuffer& buffer, const VertexBufferLayout& layout);
     void bind() const;
     void unbind() const;
+
+    private:
+    //Sets up the attribute pointers for whichever vertex buffer is bound.
+    void addAttributes(const VertexBufferLayout& layout);
 };
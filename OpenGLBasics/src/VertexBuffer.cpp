@@ -1,21 +1,43 @@
 #include "OpenGLUtil.h"
+#include "GLStateCache.h"
+#include "RedrawTracker.h"
+#include "RenderStats.h"
 #include "VertexBuffer.h"
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size) {
     GLCALL(glGenBuffers(1, &rendererId));
+    RenderStats::get().onBufferCreated();
     bind();
     GLCALL(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    RenderStats::get().onBufferUpload(size);
+    RedrawTracker::get().invalidate();
+}
+
+VertexBuffer::VertexBuffer(unsigned int size) {
+    GLCALL(glGenBuffers(1, &rendererId));
+    RenderStats::get().onBufferCreated();
+    bind();
+    GLCALL(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
 }
 
 VertexBuffer::~VertexBuffer() {
     GLCALL(glDeleteBuffers(1, &rendererId));
+    GLStateCache::get().onBufferDeleted(rendererId);
+    RenderStats::get().onBufferDeleted();
+}
+
+void VertexBuffer::setData(const void* data, unsigned int size, unsigned int offset) {
+    bind();
+    GLCALL(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+    RenderStats::get().onBufferUpload(size);
+    RedrawTracker::get().invalidate();
 }
 
 void VertexBuffer::bind() const {
-    GLCALL(glBindBuffer(GL_ARRAY_BUFFER, rendererId));
+    GLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, rendererId);
 }
 
 void VertexBuffer::unbind() const {
     //TODO: Use or not use NULL from vcruntime.h?
-    GLCALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -6,8 +6,15 @@ class VertexBuffer {
 
     public:
     VertexBuffer(const void* data, unsigned int size);
+
+    /// <summary>
+    /// Allocates an empty buffer of the given size (in bytes) for data that changes often. Fill it with <see cref="setData"/>.
+    /// </summary>
+    VertexBuffer(unsigned int size);
     ~VertexBuffer();
 
+    void setData(const void* data, unsigned int size, unsigned int offset = 0);
+
     void bind() const;
     void unbind() const;
 };
\ No newline at end of file
@@ -1,31 +1,34 @@
 #include "VertexBufferLayout.h"
 
-template<> void VertexBufferLayout::push<float>(unsigned int count) {
+template<> void VertexBufferLayout::push<float>(unsigned int count, unsigned int divisor) {
     //C++ Brace Initialization (works on classes AND structs)
     VertexBufferAttribute attribute = {
         GL_FLOAT,
         count,
-        GL_FALSE
+        GL_FALSE,
+        divisor
     };
     attributes.push_back(attribute);
     stride += count * VertexBufferAttribute::GetSizeOfType(GL_FLOAT);
 }
 
-template<> void VertexBufferLayout::push<unsigned int>(unsigned int count) {
+template<> void VertexBufferLayout::push<unsigned int>(unsigned int count, unsigned int divisor) {
     VertexBufferAttribute attribute = {
         GL_UNSIGNED_INT,
         count,
-        GL_FALSE
+        GL_FALSE,
+        divisor
     };
     attributes.push_back(attribute);
     stride += count * VertexBufferAttribute::GetSizeOfType(GL_UNSIGNED_INT);
 }
 
-template<> void VertexBufferLayout::push<unsigned char>(unsigned int count) {
+template<> void VertexBufferLayout::push<unsigned char>(unsigned int count, unsigned int divisor) {
     VertexBufferAttribute attribute = {
         GL_UNSIGNED_BYTE,
         count,
-        GL_TRUE
+        GL_TRUE,
+        divisor
     };
     attributes.push_back(attribute);
     stride += count * VertexBufferAttribute::GetSizeOfType(GL_UNSIGNED_BYTE);
@@ -10,6 +10,7 @@ struct VertexBufferAttribute {
     unsigned int type;
     unsigned int count;
     unsigned char normalized;
+    unsigned int divisor; //NOTE: 0 => advances per vertex, N => advances once every N instances.
 
     static unsigned int GetSizeOfType(unsigned int type) {
         switch (type) {
@@ -35,12 +36,14 @@ class VertexBufferLayout {
     inline unsigned int getStride() const { return stride; };
     inline const vector<VertexBufferAttribute>& GetAttributes() const { return attributes; }
 
+    /// <param name="divisor">0 for per-vertex data, or N to make this a per-instance attribute that advances once every N instances.</param>
     template<typename T>
-    void push(unsigned int count) {
-        static_assert(false);
+    void push(unsigned int count, unsigned int divisor = 0) {
+        static_assert(sizeof(T) == 0, "Unsupported vertex attribute type");
     }
-
-    template<> void push<float>(unsigned int count);
-    template<> void push<unsigned int>(unsigned int count);
-    template<> void push<unsigned char>(unsigned int count);
 };
+
+//NOTE: Declared out here, since only MSVC allows explicit specializations inside the class.
+template<> void VertexBufferLayout::push<float>(unsigned int count, unsigned int divisor);
+template<> void VertexBufferLayout::push<unsigned int>(unsigned int count, unsigned int divisor);
+template<> void VertexBufferLayout::push<unsigned char>(unsigned int count, unsigned int divisor);